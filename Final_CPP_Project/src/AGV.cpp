@@ -6,12 +6,28 @@
 /******************************Project Headers*****************************************/
 #include "AGV.h"
 #include "AssemblyStation.h"
+#include "SimTimeline.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
 /*************************************************************************************/
 
 /****************************AGV Methods**********************************************/
+/**
+ * @brief Name of an AGV state
+ */
+const char* to_string(AGVState state) {
+    switch (state) {
+        case AGVState::IDLE: return "IDLE";
+        case AGVState::TO_WAREHOUSE: return "TO_WAREHOUSE";
+        case AGVState::PICKING: return "PICKING";
+        case AGVState::TO_STATION: return "TO_STATION";
+        case AGVState::DROPPING: return "DROPPING";
+        case AGVState::RETURNING: return "RETURNING";
+    }
+    return "UNKNOWN";
+}
+
 /**
  * @brief Constructor for AGV
  * @param id Unique identifier for the AGV
@@ -19,7 +35,10 @@
 AGV::AGV(int id) 
     : agv_id(id), 
       state(AGVState::IDLE), 
+      published_state(static_cast<int>(AGVState::IDLE)),
       running(false),
+      timeline(nullptr),
+      timeline_track(-1),
       travel_time_warehouse_minutes(2),
       travel_time_station_minutes(3),
       picking_time_minutes(1),
@@ -81,40 +100,40 @@ void AGV::run() {
         int busy_increment = 0;
 
         if (!task.is_finished_product) {
-            run_segment(AGVState::TO_WAREHOUSE, travel_time_warehouse_minutes);
+            run_segment(AGVState::TO_WAREHOUSE, travel_time_warehouse_minutes, task);
             busy_increment += travel_time_warehouse_minutes;
 
-            run_segment(AGVState::PICKING, picking_time_minutes);
+            run_segment(AGVState::PICKING, picking_time_minutes, task);
             busy_increment += picking_time_minutes;
 
-            run_segment(AGVState::TO_STATION, travel_time_station_minutes);
+            run_segment(AGVState::TO_STATION, travel_time_station_minutes, task);
             busy_increment += travel_time_station_minutes;
 
-            run_segment(AGVState::DROPPING, dropping_time_minutes);
+            run_segment(AGVState::DROPPING, dropping_time_minutes, task);
             busy_increment += dropping_time_minutes;
 
             if (task.notify_station && task.destination == std::string("ASSEMBLY_STATION")) {
                 task.notify_station->notify_component_delivered(task.order_id, task.component_id, task.quantity); //<-------
             }
         } else {
-            run_segment(AGVState::TO_STATION, travel_time_station_minutes);
+            run_segment(AGVState::TO_STATION, travel_time_station_minutes, task);
             busy_increment += travel_time_station_minutes;
 
-            run_segment(AGVState::PICKING, picking_time_minutes);
+            run_segment(AGVState::PICKING, picking_time_minutes, task);
             busy_increment += picking_time_minutes;
 
-            run_segment(AGVState::TO_WAREHOUSE, travel_time_warehouse_minutes);
+            run_segment(AGVState::TO_WAREHOUSE, travel_time_warehouse_minutes, task);
             busy_increment += travel_time_warehouse_minutes;
 
-            run_segment(AGVState::DROPPING, dropping_time_minutes);
+            run_segment(AGVState::DROPPING, dropping_time_minutes, task);
             busy_increment += dropping_time_minutes;
 
             if (task.notify_station) {
-                task.notify_station->notify_finished_product_delivered(task.component_id);
+                task.notify_station->notify_finished_product_delivered(task.component_id, task.order_id);
             }
         }
 
-        run_segment(AGVState::RETURNING, return_time_minutes);
+        run_segment(AGVState::RETURNING, return_time_minutes, task);
         busy_increment += return_time_minutes;
 
         busy_time_minutes.fetch_add(busy_increment, std::memory_order_relaxed);
@@ -127,13 +146,30 @@ void AGV::run() {
     }
 }
 
-void AGV::run_segment(AGVState new_state, int minutes) {
+/**
+ * @brief Enter a state and stay in it for the given simulated time
+ * @param new_state State of this leg of the trip
+ * @param minutes Simulated duration
+ * @param task The task being carried out (timeline span details)
+ */
+void AGV::run_segment(AGVState new_state, int minutes, const AGVTask& task) {
     {
         std::lock_guard<std::mutex> lock(state_mutex); //<-------------state change
         transition_to(new_state);
     }
+    int64_t span_start = timeline ? timeline->now_us() : 0;
     if (minutes > 0) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(minutes * 100));
+        std::this_thread::sleep_for(std::chrono::milliseconds(minutes * AGV_MS_PER_MINUTE));
+    }
+    if (timeline) {
+        TimelineSpan span;
+        span.name = to_string(new_state);
+        span.start_us = span_start;
+        span.end_us = timeline->now_us();
+        span.order_id = task.order_id;
+        span.load = task.component_id;
+        span.finished_product = task.is_finished_product;
+        timeline->add_agv_span(timeline_track, std::move(span));
     }
 }
 
@@ -143,6 +179,7 @@ void AGV::run_segment(AGVState new_state, int minutes) {
  */
 void AGV::transition_to(AGVState new_state) {
     state = new_state;
+    published_state.store(static_cast<int>(new_state), std::memory_order_relaxed);
 }
 
 
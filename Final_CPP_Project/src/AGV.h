@@ -16,6 +16,10 @@
 
 // Forward declaration to avoid circular include
 class AssemblyStation;
+class SimTimeline;
+
+// Wall-clock milliseconds per simulated AGV minute
+const int AGV_MS_PER_MINUTE = 100;
 
 /****************************AGV Class Definition*************************************/
 /**
@@ -30,6 +34,8 @@ enum class AGVState {
     DROPPING,
     RETURNING
 };
+const int AGV_STATE_COUNT = 6;
+const char* to_string(AGVState state);
 
 /**
  * @struct AGVTask
@@ -55,11 +61,14 @@ class AGV {
 private:
     int agv_id;
     AGVState state;
+    std::atomic<int> published_state;   // Copy of state for lock-free readers (metrics)
     AGVTask current_task;
     mutable std::mutex state_mutex;
     std::condition_variable task_cv;
     std::atomic<bool> running;
     std::thread agv_thread;
+    SimTimeline* timeline;              // Optional state spans (this thread's track only)
+    int timeline_track;
     
     // Timing parameters (in simulated minutes)
     int travel_time_warehouse_minutes;
@@ -70,7 +79,7 @@ private:
     
     void run();
     void transition_to(AGVState new_state);
-    void run_segment(AGVState new_state, int minutes);
+    void run_segment(AGVState new_state, int minutes, const AGVTask& task);
     
 public:
     AGV(int id);
@@ -78,6 +87,7 @@ public:
     
     void start();
     void stop();
+    void set_timeline(SimTimeline* tl, int track) { timeline = tl; timeline_track = track; }
     bool assign_task(const std::string& component_id, int quantity, 
                      const std::string& destination,
                      AssemblyStation* notify_station,
@@ -85,6 +95,7 @@ public:
                      int order_id = -1);
     bool is_idle() const;
     AGVState get_state() const;
+    AGVState peek_state() const { return static_cast<AGVState>(published_state.load(std::memory_order_relaxed)); }
     int get_id() const { return agv_id; }
     AGVTask get_current_task() const;
     
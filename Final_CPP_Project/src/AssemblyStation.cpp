@@ -30,12 +30,13 @@ AssemblyStation::AssemblyStation(Warehouse* wh, std::vector<AGV*>* fleet)
     : warehouse(wh),
       agv_fleet(fleet),
       control_center(nullptr),
+      timeline(nullptr),
       products(nullptr),
+      dispatch_rule(make_dispatch_rule(SchedulingPolicy::SPT)),
       running(false),
       current_sim_time_minutes(0),
       setup_time_minutes(5),
       station_count(1),
-      ready_sequence(0),
       total_busy_time_minutes(0),
       orders_completed(0) {
 }
@@ -56,14 +57,11 @@ void AssemblyStation::start() {
     running = true;
     total_busy_time_minutes = 0;
     orders_completed = 0;
-    ready_sequence = 0;
     station_virtual_time_minutes.assign(station_count, 0);
     last_product_processed.assign(station_count, std::string());
     {
         std::lock_guard<std::mutex> ready_lock(ready_mutex);  //<---------RC--------read-----------------
-        while (!ready_queue.empty()) {
-            ready_queue.pop();
-        } 
+        ready_queue.clear();
     }
     station_threads.clear();
     for (int i = 0; i < station_count; ++i) { //This makes 
@@ -97,7 +95,7 @@ void AssemblyStation::stop() {
  */
 void AssemblyStation::process_orders(int line_id) {
     while (true) {
-        ReadySlot slot;
+        ReadyTicket ticket;
         {
             std::unique_lock<std::mutex> ready_lock(ready_mutex);      //<-----------Busy waiting Efficiency sleep---------
             ready_cv.wait(ready_lock, [this] { return !running || !ready_queue.empty(); }); //Waits new order or stop signal
@@ -107,11 +105,19 @@ void AssemblyStation::process_orders(int line_id) {
             if (ready_queue.empty()) {
                 continue;
             }
-            slot = ready_queue.top(); //Get the first ready slot (FIFO)
+            int now = current_sim_time_minutes.load();
+            ready_queue.refresh(*dispatch_rule, now, [&](const ReadyTicket& ready) {
+                return dispatch_rule->key(ready.order, get_base_time(ready.order.product_id), now);
+            });
+            ticket = ready_queue.top(); //Get the most urgent ready order (dispatch rule)
             ready_queue.pop();
         }
+        const Order& order = ticket.order;
+        if (control_center) {
+            control_center->metrics().ready_queue.add(-1);
+            control_center->metrics().queue_wait_seconds.record(agv_seconds_since(ticket.ready_since));
+        }
 
-        Order order = slot.order;
         int base_time = get_base_time(order.product_id);
         int setup_time = setup_time_minutes;
         int start_time = 0;
@@ -131,23 +137,45 @@ void AssemblyStation::process_orders(int line_id) {
         }
         int operation_time = base_time + setup_time;
         int completion_time = start_time + operation_time;
+        if (control_center) control_center->record_order_started(order.order_id, line_id, start_time, setup_time);
         {
             std::lock_guard<std::mutex> timing_lock(timing_mutex);  //<-----------------------------------------
             station_virtual_time_minutes[line_id] = completion_time;
         }
         total_busy_time_minutes.fetch_add(operation_time, std::memory_order_relaxed); //Update busy time statistic(Atomic)
 
+        int64_t span_start = timeline ? timeline->now_us() : 0;
         std::this_thread::sleep_for(std::chrono::milliseconds(operation_time * 10)); //Simulate assembly time
+        if (timeline) {
+            int64_t span_end = timeline->now_us();
+            int64_t setup_end = std::min(span_end, span_start + (int64_t)setup_time * 10000);    //One sleep covers setup + assembly
+            TimelineSpan span;
+            span.order_id = order.order_id;
+            span.load = order.product_id;
+            if (setup_time > 0) {
+                span.name = "setup";
+                span.start_us = span_start; span.end_us = setup_end;
+                span.virtual_start = start_time; span.virtual_end = start_time + setup_time;
+                timeline->add_line_span(line_id, span);
+            }
+            span.name = "assembly";
+            span.start_us = setup_end; span.end_us = span_end;
+            span.virtual_start = start_time + setup_time; span.virtual_end = completion_time;
+            timeline->add_line_span(line_id, std::move(span));
+        }
         orders_completed.fetch_add(1, std::memory_order_relaxed); //Update completed orders statistic(Atomic)
         if (control_center) { control_center->mark_order_completed(order.order_id, completion_time); } //Notify control center of completion
 
+        //Try to dispatch finished product return; a sub-assembly's parent waits for the unit, so it is retried until taken
+        bool subassembly = control_center && control_center->is_subassembly_order(order.order_id);
         bool dispatched = false;
-        for (int retry = 0; retry < 50 && !dispatched; ++retry) { //Try to dispatch finished product return
+        for (int retry = 0; !dispatched && (retry < 50 || (subassembly && running)); ++retry) {
             for (size_t i = 0; i < agv_fleet->size(); ++i) {
                 AGV* agv = (*agv_fleet)[i];
-                if (agv->assign_task(order.product_id, 1, "WAREHOUSE", this, true)) {
+                if (agv->assign_task(order.product_id, 1, "WAREHOUSE", this, true, order.order_id)) {
                     if (control_center) {
-                        control_center->log_event("[Diag] assign finished product " + order.product_id + " to AGV" + std::to_string(agv->get_id()));
+                        FAS_LOG_DIAG(control_center, log_trace(TraceEvent::PRODUCT_ASSIGNED, order.order_id, agv->get_id()));
+                        control_center->record_agv_trip(order.order_id);
                     }
                     dispatched = true;
                     break;
@@ -156,7 +184,7 @@ void AssemblyStation::process_orders(int line_id) {
             if (!dispatched) std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
         if (!dispatched && control_center) {
-            control_center->log_event("[Diag] could not dispatch finished product return for " + order.product_id + " immediately");
+            FAS_LOG_DIAG(control_center, log_trace(TraceEvent::PRODUCT_RETURN_DEFERRED, order.order_id));
         }
     }
 }
@@ -165,39 +193,125 @@ void AssemblyStation::process_orders(int line_id) {
  * @brief Staging loop to handle component requests,
  * Pulls orders from the order queue and requests components,
  * Assigns AGVs to deliver components to the assembly station.
+ * Orders whose BOM cannot be reserved are parked instead of blocking the queue,
+ * so the next feasible order is staged immediately.
  * @return void
  */
 void AssemblyStation::staging_loop() {
+    parked_orders.clear();
+    next_parked_retry = std::chrono::steady_clock::now() + parked_retry_period;
     while (running) {
         Order order;
+        bool has_new_order = false;
         {
             std::unique_lock<std::mutex> lock(queue_mutex); //<--------Polling, DL------------------
-            order_cv.wait(lock, [this] { return !running || !order_queue.empty(); }); //Waits new order or stop signal
+            auto has_work = [this] { return !running || !order_queue.empty(); };
+            if (parked_orders.empty()) {
+                order_cv.wait(lock, has_work); //Waits new order or stop signal
+            } else {
+                order_cv.wait_for(lock, std::chrono::milliseconds(100), has_work); //Wake up periodically to retry parked orders
+            }
             if (!running && order_queue.empty()) break;
-            if (order_queue.empty()) continue;
-            order = order_queue.front();
-            order_queue.pop(); // Remove order from queue(FIFO)
+            if (!order_queue.empty()) {
+                order = order_queue.front();
+                order_queue.pop(); // Remove order from queue(FIFO)
+                has_new_order = true;
+                if (control_center) control_center->metrics().order_queue.add(-1);
+            }
         }
 
-        if (!request_components(order)) {
-            int attempts = ++retry_counts[order.order_id];
-            if (attempts > max_request_retries) {
-                if (control_center) control_center->log_event("[Diag] request_components failed permanently for order ID " + std::to_string(order.order_id));
-                if (control_center) control_center->mark_order_canceled(order.order_id);
-                continue;
-            }
-            if (control_center) control_center->log_event("[Diag] request_components failed (attempt " + std::to_string(attempts) + ") requeue order " + order.product_id);
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            {
-                std::lock_guard<std::mutex> relock(queue_mutex); //<---Re-lock to push back the order into the queue
-                order_queue.push(order);
-            }
-            order_cv.notify_one(); // Notify staging thread of new order //<------------
+        retry_parked_orders();
+        if (has_new_order) stage_or_park(order);
+    }
+}
+
+/**
+ * @brief Stage a new order, or park it if its components are short
+ * or an older parked order that needs the same components is starving
+ * @param order The order to stage
+ */
+void AssemblyStation::stage_or_park(const Order& order) {
+    if (blocked_by_starving_order(order, parked_orders.size())) {
+        if (control_center) FAS_LOG_DIAG(control_center, log_trace(TraceEvent::ORDER_HELD, order.order_id));
+        parked_orders.push_back(ParkedOrder{order, 0, 0});
+        return;
+    }
+    if (!request_components(order)) {
+        if (control_center) FAS_LOG_DIAG(control_center, log_trace(TraceEvent::ORDER_PARKED, order.order_id));
+        parked_orders.push_back(ParkedOrder{order, 1, 0});
+        return;
+    }
+    for (auto& parked : parked_orders) {
+        parked.bypassed++;  //The new order overtook every parked one
+    }
+}
+
+/**
+ * @brief Retry parked orders (oldest first) when stock changed or the retry period elapsed
+ * Orders exceeding max_request_retries failed reservations are canceled; retries
+ * skipped because an older starving order holds the components do not count.
+ */
+void AssemblyStation::retry_parked_orders() {
+    if (parked_orders.empty()) return;
+    uint64_t version = warehouse->get_component_version();
+    if (version == parked_inventory_version && std::chrono::steady_clock::now() < next_parked_retry) {
+        return;
+    }
+    parked_inventory_version = version;
+    next_parked_retry = std::chrono::steady_clock::now() + parked_retry_period;
+
+    for (size_t i = 0; i < parked_orders.size() && running;) {
+        ParkedOrder& parked = parked_orders[i];
+        bool held = blocked_by_starving_order(parked.order, i);    //Waiting its turn is not a failed attempt
+        if (!held && request_components(parked.order)) {
+            if (control_center) FAS_LOG_DIAG(control_center, log_trace(TraceEvent::PARKED_ORDER_STAGED, parked.order.order_id, -1, -1, parked.attempts));
+            for (size_t j = 0; j < i; ++j) parked_orders[j].bypassed++;
+            parked_orders.erase(parked_orders.begin() + i);
+            continue;
+        }
+        if (!held && ++parked.attempts > max_request_retries) {
+            int order_id = parked.order.order_id;
+            parked_orders.erase(parked_orders.begin() + i);
+            if (control_center) FAS_LOG_DIAG(control_center, log_trace(TraceEvent::STAGING_FAILED, order_id));
+            if (control_center) control_center->mark_order_canceled(order_id);
             continue;
         }
+        ++i;
+    }
+}
 
-        retry_counts.erase(order.order_id);
+/**
+ * @brief Check whether an order must wait for an older starving parked order
+ * An order is held only if it competes for a component of a parked order that
+ * has been bypassed max_bypass_count times; orders with disjoint BOMs still go ahead.
+ * @param order The order to check
+ * @param parked_limit Only parked orders before this index are considered (older ones)
+ * @return true if the order must not be staged yet
+ */
+bool AssemblyStation::blocked_by_starving_order(const Order& order, size_t parked_limit) const {
+    for (size_t i = 0; i < parked_limit && i < parked_orders.size(); ++i) {
+        const ParkedOrder& parked = parked_orders[i];
+        if (parked.bypassed >= max_bypass_count && shares_components(parked.order, order)) {
+            return true;
+        }
     }
+    return false;
+}
+
+/**
+ * @brief Check whether two orders need at least one common component
+ */
+bool AssemblyStation::shares_components(const Order& a, const Order& b) const {
+    if (!products) return true;
+    auto pa = products->find(a.product_id);
+    auto pb = products->find(b.product_id);
+    if (pa == products->end() || pb == products->end()) return false;
+    for (const BomLine& la : pa->second.flat_bom) {
+        for (const BomLine& lb : pb->second.flat_bom) {
+            if (la.component_index == lb.component_index) return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -216,36 +330,55 @@ bool AssemblyStation::request_components(const Order& order) {
     }
     
     const Product& product = it->second;
-    if (!warehouse->reserve_components(product.bom)) {
+    BomLine shortage{-1, 0};
+    if (!warehouse->reserve_components(product.flat_bom, &shortage)) {
+        if (control_center) {
+            FAS_LOG_DIAG(control_center, log_trace(TraceEvent::COMPONENT_SHORT, order.order_id, -1,
+                                                   shortage.component_index, shortage.quantity));
+        }
         return false;
     }
+    if (control_center) control_center->record_order_staged(order.order_id);
     
+    if (product.total_units == 0) {     //Nothing to deliver: the kit is complete already
+        if (control_center) control_center->record_order_kitted(order.order_id);
+        push_ready(order);
+        return true;
+    }
     {
-        std::lock_guard<std::mutex> lk(delivery_mutex); //<---------------
-        pending_deliveries[order.order_id].clear(); 
-        for (const auto& kv : product.bom) { //Check each component in BOM and the missing quantity
-            pending_deliveries[order.order_id][kv.first] = kv.second;
+        std::lock_guard<std::mutex> lk(delivery_mutex); //<-----------Stores order until all components arrive.
+        if (order.order_id >= (int)pending_units.size()) {
+            pending_units.resize(std::max<size_t>(order.order_id + 1, pending_units.size() * 2), 0);
+            kit_started.resize(pending_units.size());
+            staged_orders.resize(pending_units.size());
         }
+        pending_units[order.order_id] = product.total_units; //Units still to be delivered for the kit
+        kit_started[order.order_id] = std::chrono::steady_clock::now();
+        staged_orders[order.order_id] = order;
     }
-    {
-        std::lock_guard<std::mutex> stage_lock(staging_mutex); //<-----------Stores order until all components arrive.
-        staging_orders[order.order_id] = order;
+    if (control_center) {
+        control_center->metrics().staging_orders.add(1);
+        control_center->metrics().pending_units.add(product.total_units);
     }
     
     int agv_index = 0;
-    for (const auto& component : product.bom) {  //Each component unit becomes one AGV task.
-        const std::string& comp_id = component.first;
-        int qty = component.second;
-        for (int q = 0; q < qty; ++q) {
+    for (const BomLine& line : product.flat_bom) {  //Each component unit becomes one AGV task.
+        const std::string& comp_id = warehouse->component_name(line.component_index);
+        for (int q = 0; q < line.quantity; ++q) {
             bool assigned = false;
+            auto requested = std::chrono::steady_clock::now();
             for (int retry = 0; retry < 50 && !assigned; ++retry) { //<--Try to assign AGV for delivery
                 for (size_t i = 0; i < agv_fleet->size(); i++) {
                     AGV* agv = (*agv_fleet)[(agv_index + i) % agv_fleet->size()];
                     if (agv->assign_task(comp_id, 1, "ASSEMBLY_STATION", this, false, order.order_id)) {
                         if (control_center) {
-                            control_center->log_event("[Diag] assign_task " + comp_id + " to AGV" + std::to_string(agv->get_id()) + " (order " + std::to_string(order.order_id) + ")");
+                            FAS_LOG_DIAG(control_center, log_trace(TraceEvent::COMPONENT_ASSIGNED, order.order_id, agv->get_id(), line.component_index));
                         }
                         assigned = true;
+                        if (control_center) {
+                            control_center->metrics().agv_response_seconds.record(agv_seconds_since(requested));
+                            control_center->record_agv_trip(order.order_id);
+                        }
                         agv_index = (agv_index + i + 1) % agv_fleet->size();
                         break;
                     }
@@ -271,50 +404,68 @@ bool AssemblyStation::request_components(const Order& order) {
  * @param quantity The quantity delivered
  */
 void AssemblyStation::notify_component_delivered(int order_id, const std::string& component_id, int quantity) {
-    if (control_center) control_center->log_event("[Diag] delivered " + component_id + " x" + std::to_string(quantity) + " for order " + std::to_string(order_id));
+#if FAS_LOG_LEVEL >= FAS_LOG_LEVEL_DIAG
+    if (control_center && control_center->log_enabled(LogLevel::DIAG)) {   //The index lookup is only needed for the log
+        int component = warehouse->find_component(component_id);
+        if (component >= 0) {
+            control_center->log_trace(TraceEvent::COMPONENT_DELIVERED, order_id, -1, component, quantity);
+        } else {
+            control_center->log_event("[Diag] delivered " + component_id + " x" + std::to_string(quantity) + " for order " + std::to_string(order_id));
+        }
+    }
+#else
+    (void)component_id;
+#endif
     Order ready_order;
     bool order_ready = false;
     {
         std::lock_guard<std::mutex> lk(delivery_mutex);    //<------------Updates remaining quantity.
-        auto order_it = pending_deliveries.find(order_id);  //search for the order
-        if (order_it == pending_deliveries.end()) {
-            return;
-        }
-        auto comp_it = order_it->second.find(component_id);
-        if (comp_it != order_it->second.end()) {
-            comp_it->second -= quantity;
-            if (comp_it->second <= 0) comp_it->second = 0;
+        if (order_id < 0 || order_id >= (int)pending_units.size() || pending_units[order_id] <= 0) {
+            return;     //Not a kit in progress
         }
-        bool all_done = true;
-        for (const auto& kv : order_it->second) {
-            if (kv.second > 0) {
-                all_done = false;
-                break;
-            }
-        }
-        if (all_done) { //Checks if entire BOM is fulfilled.
-            pending_deliveries.erase(order_it);
-            {
-                std::lock_guard<std::mutex> stage_lock(staging_mutex); //<---------Moves order from staging → ready.
-                auto staged = staging_orders.find(order_id);
-                if (staged != staging_orders.end()) {
-                    ready_order = staged->second;
-                    staging_orders.erase(staged);
-                    order_ready = true;
-                }
+        int delivered = std::min(quantity, pending_units[order_id]);
+        pending_units[order_id] -= delivered;
+        if (control_center) control_center->metrics().pending_units.add(-delivered);
+        if (pending_units[order_id] == 0) { //Checks if entire BOM is fulfilled.
+            if (control_center) {
+                control_center->metrics().staging_orders.add(-1);
+                control_center->metrics().kit_prep_seconds.record(agv_seconds_since(kit_started[order_id]));
+                control_center->record_order_kitted(order_id);
             }
+            ready_order = std::move(staged_orders[order_id]);   //<---------Moves order from staging → ready.
+            order_ready = true;
         }
     }
 
     if (order_ready) {
-        if (control_center) control_center->log_event("[Diag] all components delivered for order " + std::to_string(order_id));
-        std::lock_guard<std::mutex> ready_lock(ready_mutex); //block to push ready order <<-------------------------------------
-        ReadySlot slot{ready_order, get_base_time(ready_order.product_id), ready_sequence.fetch_add(1, std::memory_order_relaxed)};
-        ready_queue.push(slot);
-        ready_cv.notify_all();  // Wake all station threads so any idle one can pick up wor, if there are multiple lines 
+        if (control_center) FAS_LOG_DIAG(control_center, log_trace(TraceEvent::KIT_COMPLETE, order_id));
+        push_ready(ready_order);
     }
 }
 
+/**
+ * @brief Elapsed wall time converted to simulated seconds on the AGV clock
+ * @param start Start of the interval
+ * @return Simulated seconds since start
+ */
+int64_t AssemblyStation::agv_seconds_since(std::chrono::steady_clock::time_point start) {
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    return (int64_t)elapsed_ms * 60 / AGV_MS_PER_MINUTE;
+}
+
+
+/**
+ * @brief Move a kitted order into the ready queue and wake the assembly lines
+ * @param order The order whose kit is complete
+ */
+void AssemblyStation::push_ready(const Order& order) {
+    std::lock_guard<std::mutex> ready_lock(ready_mutex); //block to push ready order <<-------------------------------------
+    ready_queue.push(ReadyTicket{order, std::chrono::steady_clock::now()}, order, *dispatch_rule,
+                     get_base_time(order.product_id), current_sim_time_minutes.load());
+    if (control_center) control_center->metrics().ready_queue.add(1);
+    ready_cv.notify_all();  // Wake all station threads so any idle one can pick up wor, if there are multiple lines 
+}
+
 /**
  * @brief Check if the assembly station is currently processing orders
  * @return true if processing, false otherwise
@@ -367,6 +518,7 @@ int AssemblyStation::get_base_time(const std::string& product_id) const {
 void AssemblyStation::add_order(const Order& order) {
     std::lock_guard<std::mutex> lock(queue_mutex); //<-----------------------------------------------------------------------------
     order_queue.push(order);    //Safe push to order queue
+    if (control_center) control_center->metrics().order_queue.add(1);
     order_cv.notify_one(); //<----------------------------------------------------------------------------- 
 }
 
@@ -382,16 +534,40 @@ void AssemblyStation::set_simulation_time(int minutes) {
 
 /**
  * @brief Notify the assembly station that a finished product has been delivered
+ * Sub-assemblies go back into component stock so their parent order can reserve them.
  * @param product_id The ID of the delivered finished product
+ * @param order_id The order that produced it (-1 if unknown)
  */
-void AssemblyStation::notify_finished_product_delivered(const std::string& product_id) {
+void AssemblyStation::notify_finished_product_delivered(const std::string& product_id, int order_id) {
     if (control_center) {
-        control_center->log_event("[Diag] finished product delivered " + product_id);
+        if (order_id >= 0) {
+            FAS_LOG_DIAG(control_center, log_trace(TraceEvent::PRODUCT_DELIVERED, order_id));
+        } else {
+            FAS_LOG_DIAG(control_center, log_event("[Diag] finished product delivered " + product_id));
+        }
+    }
+    if (control_center && control_center->is_subassembly_order(order_id)) {
+        warehouse->add_component(product_id, 1);    //Stock first, then the parent may be released
+        control_center->mark_subassembly_stocked(order_id);
+        return;
     }
     warehouse->add_finished_product(product_id);  //Add finished product to warehouse inventory
 }
 
 
+/**
+ * @brief Select the dispatch rule used to rank kitted orders in the ready queue
+ * @param policy The scheduling policy
+ * @param mean_processing_minutes Average processing time (used by ATC)
+ */
+void AssemblyStation::set_scheduling_policy(SchedulingPolicy policy, double mean_processing_minutes) {
+    if (running) {
+        return;
+    }   //The ready queue keys must come from a single rule.
+    dispatch_rule = make_dispatch_rule(policy, mean_processing_minutes);
+}
+
+
 /**
  * @brief Set the number of assembly lines in the station
  * @param count The number of assembly lines
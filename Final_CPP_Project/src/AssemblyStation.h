@@ -9,6 +9,8 @@
 #include "Order.h"
 #include "Product.h"
 #include "Warehouse.h"
+#include "DispatchRule.h"
+#include "SimTimeline.h"
 
 /*************************************************************************************/
 
@@ -18,6 +20,8 @@ class ControlCenter;
 #include <map>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <chrono>
 #include <mutex>
 #include <thread>
 #include <atomic>
@@ -32,26 +36,18 @@ class ControlCenter;
  */
 class AssemblyStation {
 private:
-    struct ReadySlot {
-        Order order;
-        int estimated_time;
-        uint64_t sequence;
-    };
-    struct ReadySlotCompare {
-        bool operator()(const ReadySlot& a, const ReadySlot& b) const {
-            if (a.estimated_time != b.estimated_time) {     
-                return a.estimated_time > b.estimated_time;
-            }
-            return a.sequence > b.sequence;
-        }
-    };
-
     Warehouse* warehouse;
     std::vector<AGV*>* agv_fleet;
     ControlCenter* control_center;
+    SimTimeline* timeline;            // Optional setup/assembly spans per line
     std::map<std::string, Product>* products;
     std::queue<Order> order_queue;
-    std::priority_queue<ReadySlot, std::vector<ReadySlot>, ReadySlotCompare> ready_queue;
+    struct ReadyTicket {
+        Order order;
+        std::chrono::steady_clock::time_point ready_since;  // Kit completion (queue wait metric)
+    };
+    DispatchQueue<ReadyTicket> ready_queue;       // Kitted orders ranked by dispatch_rule
+    std::unique_ptr<DispatchRule> dispatch_rule;  // Ready-queue dispatch rule (default SPT)
     mutable std::mutex queue_mutex;   // Mutex for order queue
     mutable std::mutex ready_mutex;   // Mutex for ready queue
     std::condition_variable order_cv; // Notify staging thread of new orders
@@ -67,25 +63,39 @@ private:
 
     void process_orders(int line_id);
     void staging_loop();
+    void stage_or_park(const Order& order);
+    void retry_parked_orders();
+    bool blocked_by_starving_order(const Order& order, size_t parked_limit) const;
+    bool shares_components(const Order& a, const Order& b) const;
     bool request_components(const Order& order);
+    void push_ready(const Order& order);
+    static int64_t agv_seconds_since(std::chrono::steady_clock::time_point start);
     int calculate_operation_time(const std::string& product_id);
     int get_base_time(const std::string& product_id) const;
 
     // Delivery coordination
     std::mutex delivery_mutex;
-    std::map<int, std::map<std::string, int>> pending_deliveries;
-    std::mutex staging_mutex;
-    std::map<int, Order> staging_orders;
+    std::vector<int> pending_units;     // order_id -> units still to be delivered (0 = no kit in progress)
+    std::vector<std::chrono::steady_clock::time_point> kit_started;    // order_id -> reservation time
+    std::vector<Order> staged_orders;   // order_id -> order waiting for its kit
 
-    // Retry control
-    std::map<int, int> retry_counts;
+    // Skip-ahead staging: orders that could not be reserved wait here (staging thread only)
+    struct ParkedOrder {
+        Order order;
+        int attempts;   // Failed reservation attempts
+        int bypassed;   // Orders staged ahead of this one since it was parked
+    };
+    std::deque<ParkedOrder> parked_orders;
+    uint64_t parked_inventory_version = 0;
+    std::chrono::steady_clock::time_point next_parked_retry;   // Periodic retry deadline when stock is unchanged
+    const std::chrono::milliseconds parked_retry_period{100};
     const int max_request_retries = 100;
+    const int max_bypass_count = 8;     // Anti-starvation bound for parked orders
 
     // Multi-line timing helpers
     mutable std::mutex timing_mutex;
     std::vector<int> station_virtual_time_minutes;
     std::vector<std::string> last_product_processed;
-    std::atomic<uint64_t> ready_sequence;
 
     // Statistics
     std::atomic<int> total_busy_time_minutes;
@@ -102,9 +112,12 @@ public:
     void set_simulation_time(int minutes);
     void set_products(std::map<std::string, Product>* prods) { products = prods; }
     void set_control_center(ControlCenter* cc) { control_center = cc; }
+    void set_timeline(SimTimeline* tl) { timeline = tl; }
+    int get_station_count() const { return station_count; }
+    void set_scheduling_policy(SchedulingPolicy policy, double mean_processing_minutes);
 
     void notify_component_delivered(int order_id, const std::string& component_id, int quantity);
-    void notify_finished_product_delivered(const std::string& product_id);
+    void notify_finished_product_delivered(const std::string& product_id, int order_id = -1);
 
     int get_total_busy_time() const { return total_busy_time_minutes.load(); }
     int get_orders_completed() const { return orders_completed.load(); }
@@ -0,0 +1,185 @@
+/**
+ * @file AsyncLogger.cpp
+ * @brief Asynchronous ring-buffer logger implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "AsyncLogger.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <chrono>
+#include <cstdio>
+/*************************************************************************************/
+
+/****************************AsyncLogger Methods**************************************/
+
+/**
+ * @brief Constructor for AsyncLogger
+ * @param capacity Ring size, rounded up to a power of two
+ * @param console Echo every record to stdout as well
+ */
+AsyncLogger::AsyncLogger(size_t capacity, bool console)
+    : mask(0), enqueue_pos(0), dequeue_pos(0), written(0), running(false), writer_sleeping(false),
+      echo_console(console) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    slots.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+    mask = size - 1;
+}
+
+/**
+ * @brief Destructor for AsyncLogger
+ */
+AsyncLogger::~AsyncLogger() {
+    close();
+}
+
+
+/**
+ * @brief Open the log file, write its header and start the writer thread
+ * @param filename Path of the log file (truncated)
+ * @param header Text written before the first record
+ * @return true if the file could be opened; records are still echoed otherwise
+ */
+bool AsyncLogger::open(const std::string& filename, const std::string& header) {
+    file.reset(new BufferedWriter(filename));
+    bool opened = file->is_open();
+    if (opened) {
+        file->put(header);
+        file->flush();
+    } else {
+        file.reset();
+    }
+    running = true;
+    writer_thread = std::thread(&AsyncLogger::writer_loop, this);
+    return opened;
+}
+
+
+/**
+ * @brief Queue one record; never blocks unless the ring is full
+ * @param sim_minutes Simulation time printed before the message
+ * @param message The message (moved into the ring)
+ */
+void AsyncLogger::log(int sim_minutes, std::string message) {
+    uint64_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[pos & mask];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)sequence - (int64_t)pos;
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {      //Full: let the writer catch up
+            wake_writer();
+            std::this_thread::yield();
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        } else {                    //Another producer took this slot
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->sim_minutes = sim_minutes;
+    slot->message = std::move(message);
+    slot->sequence.store(pos + 1, std::memory_order_seq_cst);
+    if (writer_sleeping.load(std::memory_order_seq_cst)) wake_writer();
+}
+
+
+/**
+ * @brief Wake the writer if it is waiting for records
+ */
+void AsyncLogger::wake_writer() {
+    std::lock_guard<std::mutex> lock(wake_mutex);
+    wake_cv.notify_one();
+}
+
+
+/**
+ * @brief Write every published record; called by the writer thread only
+ * @param console_batch Reused buffer for the console copy of the batch
+ * @return Number of records written
+ */
+size_t AsyncLogger::drain(std::string& console_batch) {
+    size_t count = 0;
+    console_batch.clear();
+    while (true) {
+        Slot& slot = slots[dequeue_pos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) break;
+
+        char prefix[16];
+        int minutes = slot.sim_minutes;
+        int length = std::snprintf(prefix, sizeof(prefix), "%02d:%02d ", minutes / 60, minutes % 60);
+        if (file) {
+            file->write(prefix, (size_t)length).put(slot.message).put('\n');
+        }
+        if (echo_console) {
+            console_batch.append(prefix, (size_t)length).append(slot.message).push_back('\n');
+        }
+
+        slot.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);  //Hand the slot back
+        ++dequeue_pos;
+        ++count;
+    }
+    if (count > 0) {
+        if (file) file->flush();
+        if (echo_console) {
+            std::fwrite(console_batch.data(), 1, console_batch.size(), stdout);
+            std::fflush(stdout);
+        }
+        written.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+
+/**
+ * @brief Writer thread: drain in batches, sleep briefly when the ring is empty
+ */
+void AsyncLogger::writer_loop() {
+    std::string console_batch;
+    while (running.load(std::memory_order_acquire)) {
+        if (drain(console_batch) > 0) continue;
+        writer_sleeping.store(true, std::memory_order_seq_cst);
+        const Slot& next = slots[dequeue_pos & mask];
+        if (next.sequence.load(std::memory_order_seq_cst) != dequeue_pos + 1 && running) {
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake_cv.wait_for(lock, std::chrono::milliseconds(10));  //Timeout bounds a missed wake-up
+        }
+        writer_sleeping.store(false, std::memory_order_relaxed);
+    }
+    while (dequeue_pos != enqueue_pos.load(std::memory_order_acquire)) {   //Records claimed before close()
+        if (drain(console_batch) == 0) std::this_thread::yield();
+    }
+}
+
+
+/**
+ * @brief Wait until every record logged before the call has been written
+ */
+void AsyncLogger::flush() {
+    uint64_t target = enqueue_pos.load(std::memory_order_acquire);
+    if (!writer_thread.joinable()) return;
+    while (written.load(std::memory_order_acquire) < target) {
+        wake_writer();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+
+/**
+ * @brief Drain the ring, stop the writer thread and close the file
+ */
+void AsyncLogger::close() {
+    if (writer_thread.joinable()) {
+        running = false;
+        wake_writer();
+        writer_thread.join();
+    }
+    if (file) {
+        file->close();
+        file.reset();
+    }
+}
+/*************************************************************************************/
@@ -0,0 +1,71 @@
+/**
+ * @file AsyncLogger.h
+ * @brief Lock-free multi-producer log queue drained by a background writer
+ */
+
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+/******************************Project Headers*****************************************/
+#include "BufferedWriter.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+/*************************************************************************************/
+
+/****************************AsyncLogger Class Definition*****************************/
+/**
+ * @class AsyncLogger
+ * @brief Bounded MPSC ring buffer of (sim time, message) records
+ *
+ * Producers claim a slot with one CAS and publish it through the slot's
+ * sequence number; they never take a lock unless the writer is asleep (to
+ * wake it) or the ring is full (they yield until the writer catches up).
+ * The writer thread drains records in batches, formats the "HH:MM" prefix
+ * and writes each batch to the log file and the console in one call.
+ */
+class AsyncLogger {
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        int sim_minutes;
+        std::string message;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    uint64_t mask;
+    alignas(64) std::atomic<uint64_t> enqueue_pos;
+    alignas(64) uint64_t dequeue_pos;           // Writer thread only
+    std::atomic<uint64_t> written;              // Records written so far (flush)
+    std::atomic<bool> running;
+    std::atomic<bool> writer_sleeping;
+    std::mutex wake_mutex;                      // Only used to sleep/wake the idle writer
+    std::condition_variable wake_cv;
+    std::thread writer_thread;
+    std::unique_ptr<BufferedWriter> file;
+    bool echo_console;
+
+    void writer_loop();
+    size_t drain(std::string& console_batch);
+    void wake_writer();
+
+public:
+    explicit AsyncLogger(size_t capacity = 8192, bool console = true);
+    ~AsyncLogger();
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    bool open(const std::string& filename, const std::string& header);
+    void log(int sim_minutes, std::string message);
+    void flush();       // Wait until every record logged so far is written
+    void close();       // Drain, stop the writer and close the file
+};
+/*************************************************************************************/
+#endif /* ASYNC_LOGGER_H */
@@ -0,0 +1,116 @@
+/**
+ * @file BomExplosion.cpp
+ * @brief Multi-level BOM explosion implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "BomExplosion.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <queue>
+/*************************************************************************************/
+
+const std::vector<std::pair<std::string, int>> BomExplosion::no_subassemblies;
+const std::map<std::string, int> BomExplosion::no_requirements;
+
+/****************************BomExplosion Methods************************************/
+
+/**
+ * @brief Build the product DAG and memoize levels and raw requirements
+ * @param products Loaded products; BOM entries naming a product are sub-assemblies
+ * @param error Set to a description when the graph has a cycle
+ * @return true if the BOM is a DAG, false otherwise
+ */
+bool BomExplosion::build(const std::map<std::string, Product>& products, std::string& error) {
+    nodes.clear();
+    order.clear();
+
+    std::map<std::string, int> pending_children;                 //Unresolved sub-assemblies per product
+    std::map<std::string, std::vector<std::string>> parents;     //Child -> products that use it
+    for (const auto& kv : products) {
+        Node& node = nodes[kv.first];
+        for (const auto& entry : kv.second.bom) {
+            if (products.count(entry.first)) {
+                node.subassemblies.emplace_back(entry.first, entry.second);
+                parents[entry.first].push_back(kv.first);
+            }
+        }
+        pending_children[kv.first] = (int)node.subassemblies.size();
+    }
+
+    // Kahn's algorithm: a product is ready once all of its sub-assemblies are
+    std::queue<std::string> ready;
+    for (const auto& kv : pending_children) {
+        if (kv.second == 0) ready.push(kv.first);
+    }
+    while (!ready.empty()) {
+        std::string id = ready.front();
+        ready.pop();
+        order.push_back(id);
+
+        Node& node = nodes[id];
+        for (const auto& entry : products.at(id).bom) {
+            if (!products.count(entry.first)) node.raw_requirements[entry.first] += entry.second;
+        }
+        for (const auto& child : node.subassemblies) {  //Children are already memoized
+            const Node& child_node = nodes[child.first];
+            node.level = std::max(node.level, child_node.level + 1);
+            for (const auto& raw : child_node.raw_requirements) {
+                node.raw_requirements[raw.first] += raw.second * child.second;
+            }
+        }
+        for (const auto& parent : parents[id]) {
+            if (--pending_children[parent] == 0) ready.push(parent);
+        }
+    }
+
+    if (order.size() != products.size()) {
+        error = "BOM contains a cycle involving:";
+        for (const auto& kv : pending_children) {
+            if (kv.second > 0) error += " " + kv.first;
+        }
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Check whether any product uses a sub-assembly
+ */
+bool BomExplosion::has_subassemblies() const {
+    for (const auto& kv : nodes) {
+        if (!kv.second.subassemblies.empty()) return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Level of a product in the BOM (0 = made from raw components only)
+ */
+int BomExplosion::level(const std::string& product_id) const {
+    auto it = nodes.find(product_id);
+    return (it != nodes.end()) ? it->second.level : 0;
+}
+
+
+/**
+ * @brief Direct sub-assemblies of a product with their quantities
+ */
+const std::vector<std::pair<std::string, int>>& BomExplosion::subassemblies(const std::string& product_id) const {
+    auto it = nodes.find(product_id);
+    return (it != nodes.end()) ? it->second.subassemblies : no_subassemblies;
+}
+
+
+/**
+ * @brief Raw components needed for one unit, including all sub-assembly levels
+ */
+const std::map<std::string, int>& BomExplosion::raw_requirements(const std::string& product_id) const {
+    auto it = nodes.find(product_id);
+    return (it != nodes.end()) ? it->second.raw_requirements : no_requirements;
+}
+/*************************************************************************************/
@@ -0,0 +1,51 @@
+/**
+ * @file BomExplosion.h
+ * @brief Multi-level BOM: product DAG, topological order and memoized explosion
+ */
+
+#ifndef BOM_EXPLOSION_H
+#define BOM_EXPLOSION_H
+
+/******************************Project Headers*****************************************/
+#include "Product.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <map>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/****************************BomExplosion Class Definition****************************/
+/**
+ * @class BomExplosion
+ * @brief Treats BOM entries that name another product as sub-assemblies
+ *
+ * build() sorts the product graph topologically (sub-assemblies first) and
+ * memoizes, per product, its level and its fully exploded raw component needs.
+ */
+class BomExplosion {
+private:
+    struct Node {
+        int level = 0;                                          // 0 = raw components only
+        std::vector<std::pair<std::string, int>> subassemblies; // Direct child products
+        std::map<std::string, int> raw_requirements;            // Exploded raw components per unit
+    };
+
+    std::map<std::string, Node> nodes;
+    std::vector<std::string> order;     // Topological order, leaves first
+    static const std::vector<std::pair<std::string, int>> no_subassemblies;
+    static const std::map<std::string, int> no_requirements;
+
+public:
+    bool build(const std::map<std::string, Product>& products, std::string& error);
+
+    bool is_product(const std::string& id) const { return nodes.count(id) > 0; }
+    bool has_subassemblies() const;
+    int level(const std::string& product_id) const;
+    const std::vector<std::string>& topological_order() const { return order; }
+    const std::vector<std::pair<std::string, int>>& subassemblies(const std::string& product_id) const;
+    const std::map<std::string, int>& raw_requirements(const std::string& product_id) const;
+};
+/*************************************************************************************/
+#endif /* BOM_EXPLOSION_H */
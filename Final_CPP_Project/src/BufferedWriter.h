@@ -0,0 +1,88 @@
+/**
+ * @file BufferedWriter.h
+ * @brief Append-only file writer with a fixed in-memory buffer
+ */
+
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+/*****************************Standard Libraries***************************************/
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/****************************BufferedWriter Class Definition**************************/
+/**
+ * @class BufferedWriter
+ * @brief Collects output in a buffer and hands it to the OS in large writes
+ *
+ * Numbers are formatted with snprintf straight into the buffer, so writing a
+ * row costs no temporary strings or stream state.
+ */
+class BufferedWriter {
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;
+
+public:
+    explicit BufferedWriter(const std::string& filename, size_t capacity = 64 * 1024)
+        : file(std::fopen(filename.c_str(), "wb")), buffer(capacity), used(0), failed(file == nullptr) {}
+    ~BufferedWriter() { close(); }
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool is_open() const { return file != nullptr; }
+    bool good() const { return !failed; }
+
+    void flush() {
+        if (file && used > 0) {
+            if (std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+            used = 0;
+        }
+    }
+
+    // Flush and close; returns false if any write failed
+    bool close() {
+        if (file) {
+            flush();
+            if (std::fclose(file) != 0) failed = true;
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+    BufferedWriter& write(const char* data, size_t size) {
+        if (used + size > buffer.size()) flush();
+        if (size > buffer.size()) {     //Too large to buffer: write through
+            if (file && std::fwrite(data, 1, size, file) != size) failed = true;
+            return *this;
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+        return *this;
+    }
+
+    BufferedWriter& put(char c) { return write(&c, 1); }
+    BufferedWriter& put(const char* text) { return write(text, std::strlen(text)); }
+    BufferedWriter& put(const std::string& text) { return write(text.data(), text.size()); }
+
+    BufferedWriter& put(long long value) {
+        char digits[24];
+        int n = std::snprintf(digits, sizeof(digits), "%lld", value);
+        return write(digits, (size_t)n);
+    }
+    BufferedWriter& put(int value) { return put((long long)value); }
+    BufferedWriter& put(long value) { return put((long long)value); }
+
+    BufferedWriter& put(double value) {
+        char digits[32];
+        int n = std::snprintf(digits, sizeof(digits), "%.6g", value);
+        return write(digits, (size_t)n);
+    }
+};
+/*************************************************************************************/
+#endif /* BUFFERED_WRITER_H */
@@ -13,9 +13,10 @@
 #include <iostream>  //console output
 #include <algorithm> //stl algorithms
 #include <sstream>   //stringstream
-#include <iomanip>   //format time output
 #include <thread>    //thread wait and signal
 #include <chrono>   //time functions
+#include <queue>    //release event queue
+#include <functional> //std::greater
 /*************************************************************************************/
 
 using std::cout;
@@ -24,20 +25,31 @@ using std::stringstream;
 
 /**
  * @brief Constructor for ControlCenter
+ * @param log_file Text log path ("" = console only)
  */
-ControlCenter::ControlCenter()
+ControlCenter::ControlCenter(const std::string& log_file)
     : policy(SchedulingPolicy::FIFO),
       current_sim_time_minutes(0),
       simulation_running(false),
       has_stopped(false),
       assembly_station(nullptr),
+      warehouse(nullptr),
+      kpi_report_file("output/kpi_report.txt"),
+      kpi_json_file("output/kpi_report.json"),
+      order_results_file("output/order_results.csv"),
       completed_orders(0),
       scheduler_done(false),
-      enable_diag_logs(true) {
-    log_file.open("output/sim_log.txt", std::ios::out);
-    if (log_file.is_open()) {
-        log_file << "=== Simulation Log ===\n\n";
-    }
+      order_count(0),
+      order_capacity(0),
+      next_customer_id(1),
+      customer_id_limit(1),
+      next_subassembly_id(1),
+      log_level(static_cast<int>(LogLevel::DIAG)),
+      conwip_cap(0),
+      wip_count(0),
+      max_wip(0),
+      last_exit_minutes(0) {
+    logger.open(log_file, "=== Simulation Log ===\n\n");
 }
 
 /**
@@ -47,9 +59,11 @@ ControlCenter::~ControlCenter() {
     if (!has_stopped.load()) {
         stop_simulation();
     }
-    if (log_file.is_open()) {
-        log_file.close();
+    if (event_trace.is_open()) {
+        build_trace_names();
+        event_trace.close(trace_names);
     }
+    logger.close();
 }
 
 /**
@@ -61,23 +75,74 @@ bool ControlCenter::load_orders(const std::string& filename) {
     return FileHandler::read_orders_file(filename, orders);
 }
 
+/**
+ * @brief Load orders, BOM and inventory from a compiled scenario image
+ * @param image Opened scenario image
+ * @param wh Pointer to Warehouse instance
+ * @return true if the BOM is valid
+ */
+bool ControlCenter::load_scenario(const ScenarioImage& image, Warehouse* wh) {
+    std::map<std::string, int> inventory;
+    image.load(orders, products, inventory);
+    std::string error;
+    if (!bom_explosion.build(products, error)) {
+        std::cerr << "Error: " << error << " in scenario image" << std::endl;
+        return false;
+    }
+    warehouse = wh;
+    for (const auto& item : inventory) {
+        warehouse->add_component(item.first, item.second);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Read orders from a growing file or FIFO while the simulation runs
+ * Orders are parsed as they arrive and released by the scheduler in arrival
+ * order; order slots for up to capacity orders (sub-assemblies included) are
+ * allocated when the simulation starts.
+ * @param path Path of the orders file or named pipe
+ * @param follow Keep reading a regular file as it grows, until a line "END"
+ * @param capacity Maximum number of orders in the run
+ * @return true if the stream was opened
+ */
+bool ControlCenter::stream_orders(const std::string& path, bool follow, size_t capacity) {
+    order_stream.reset(new OrderStream());
+    if (!order_stream->open(path, follow)) {
+        order_stream.reset();
+        return false;
+    }
+    order_capacity = capacity;
+    return true;
+}
+
 /**
  * @brief Load BOM from file
  * @param filename Path to BOM file
  * @return true if successful, false otherwise
  */
 bool ControlCenter::load_bom(const std::string& filename) {
-    return FileHandler::read_bom_file(filename, products);
+    if (!FileHandler::read_bom_file(filename, products)) {
+        return false;
+    }
+    std::string error;
+    if (!bom_explosion.build(products, error)) {
+        std::cerr << "Error: " << error << " in " << filename << std::endl;
+        return false;
+    }
+    return true;
 }
 
 
 /**
  * @brief Load warehouse inventory from file
  * @param filename Path to warehouse file
- * @param warehouse Pointer to Warehouse instance
+ * @param wh Pointer to Warehouse instance
  * @return true if successful, false otherwise
  */
-bool ControlCenter::load_warehouse(const std::string& filename, Warehouse* warehouse) {
+bool ControlCenter::load_warehouse(const std::string& filename, Warehouse* wh) {
+    warehouse = wh;
     std::map<std::string, int> inventory;
     if (!FileHandler::read_warehouse_file(filename, inventory)) {
         return false;
@@ -98,12 +163,30 @@ void ControlCenter::start_simulation(AssemblyStation* station, std::vector<AGV*>
     assembly_station = station;
     agv_fleet = fleet;
 
+    if (warehouse) {
+        for (auto& kv : products) { warehouse->compile_bom(kv.second); }   //Flat BOMs reused by every order
+        warehouse->publish_components();   //Every component is registered now; size the metrics view
+    }
+
+    expand_subassembly_orders();
+    double mean_processing = mean_processing_time();
+    dispatch_rule = make_dispatch_rule(policy, mean_processing);
+
     if (assembly_station) {
         assembly_station->set_products(&products);
+        assembly_station->set_scheduling_policy(policy, mean_processing);
         assembly_station->set_control_center(this);
         assembly_station->set_simulation_time(current_sim_time_minutes.load());
     }
 
+    if (!timeline_file.empty()) {      //Wire the recorder before any thread can produce a span
+        timeline.reset(agv_fleet ? (int)agv_fleet->size() : 0, assembly_station ? assembly_station->get_station_count() : 0);
+        if (assembly_station) assembly_station->set_timeline(&timeline);
+        for (size_t i = 0; agv_fleet && i < agv_fleet->size(); ++i) {
+            if ((*agv_fleet)[i]) (*agv_fleet)[i]->set_timeline(&timeline, (int)i);
+        }
+    }
+
     if (agv_fleet) {
         for (auto* agv : *agv_fleet) {
             if (agv) agv->start();
@@ -118,20 +201,12 @@ void ControlCenter::start_simulation(AssemblyStation* station, std::vector<AGV*>
     has_stopped = false;
     completed_orders = 0;
     scheduler_done = false;
+    sim_metrics.reset();
 
-    if (policy == SchedulingPolicy::FIFO) {
-        std::sort(orders.begin(), orders.end(), //STL sort by release time
-            [](const Order& a, const Order& b) { return a.release_time_minutes < b.release_time_minutes; });
-    } else if (policy == SchedulingPolicy::PRIORITY) {
-        std::sort(orders.begin(), orders.end(), //STL sort by priority
-            [](const Order& a, const Order& b) {
-                if (a.priority != b.priority) return a.priority > b.priority;
-                return a.release_time_minutes < b.release_time_minutes;
-            });
-    }
-
+    build_order_index();
+    build_trace_names();
     scheduler_thread = std::thread(&ControlCenter::scheduler_loop, this); //start scheduler thread 
-    log_event("Simulation started");    //the job of the log event is to log the events in the log file
+    FAS_LOG_INFO(this, log_event("Simulation started"));    //the job of the log event is to log the events in the log file
 }
 
 
@@ -143,6 +218,7 @@ void ControlCenter::stop_simulation() {
 
     simulation_running = false;
     if (scheduler_thread.joinable()) { scheduler_thread.join(); } //wait for scheduler thread to finish
+    if (order_stream) { order_stream->close(); }
 
     if (assembly_station) { assembly_station->stop(); }
 
@@ -157,9 +233,18 @@ void ControlCenter::stop_simulation() {
         for (auto* agv : *agv_fleet) { if (agv) agv->stop(); }
     }
 
+    orders.resize(order_count.load());     //Every thread has stopped: drop unused streaming slots
     compute_kpis();
-    log_event("KPIs computed and saved");
-    log_event("Simulation stopped");
+    if (!timeline_file.empty()) {
+        FileHandler::write_chrome_trace(timeline_file, timeline);
+    }
+    FAS_LOG_INFO(this, log_event("KPIs computed and saved"));
+    FAS_LOG_INFO(this, log_event("Simulation stopped"));
+    logger.flush();     // Everything logged so far reaches the console before main() prints again
+    if (event_trace.is_open()) {
+        build_trace_names();                            // Components registered during the run too
+        event_trace.close(trace_names);
+    }
 }
 
 
@@ -169,39 +254,187 @@ void ControlCenter::stop_simulation() {
 void ControlCenter::wait_until_all_orders_complete() {
     std::unique_lock<std::mutex> lk(completion_mutex);  // Lock for condition variable  <------------------------------
     completion_cv.wait(lk, [this]{                      // Wait until all orders are completed
-        return completed_orders.load() == (int)orders.size();    // scheduler is done
+        return completed_orders.load() == order_count.load() &&    // scheduler is done
+               (!order_stream || scheduler_done.load());            // and no more orders can arrive
     });
 }
 
 /**
  * @brief Main scheduler loop
+ * Release events are processed in time order so the simulation clock never runs
+ * backwards; the dispatch rule only ranks orders released at the same instant.
+ * With CONWIP enabled, a released order is admitted only while the WIP cap and
+ * its family's kanban cards allow it; otherwise the loop waits for an order to leave.
  */
 void ControlCenter::scheduler_loop() {
     int sim_start_time = 0;
     current_sim_time_minutes = sim_start_time;
 
-    for (auto& order : orders) {
-        if (!simulation_running) break;
-        current_sim_time_minutes = order.release_time_minutes;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        release_order(order);
+    ReleaseQueue release_events;
+    for (size_t i = 0; i < (size_t)order_count.load(); ++i) {
+        if (orders[i].parent_order_id >= 0) continue;   //Sub-assemblies are admitted with their parent
+        release_events.push(ReleaseEvent{orders[i].release_time_minutes, i});
+    }
+
+    DispatchQueue<size_t> released;     //Orders whose release time has been reached
+    bool blocked = false;
+    bool streaming = order_stream != nullptr;
+    while ((!release_events.empty() || !released.empty() || streaming) && simulation_running) {
+        if (streaming) {
+            streaming = ingest_streamed_orders(release_events, released.size());
+            if (streaming && release_events.empty() && released.empty()) {
+                order_stream->wait(std::chrono::milliseconds(100));     //Idle until the next order arrives
+                continue;
+            }
+        }
+
+        if (!release_events.empty() && (released.empty() || blocked)) {
+            int now = std::max(release_events.top().time_minutes, current_sim_time_minutes.load());
+            current_sim_time_minutes = now; //Clock only moves forward
+            while (!release_events.empty() && release_events.top().time_minutes <= now) {
+                size_t index = release_events.top().order_index;
+                release_events.pop();
+                released.push(index, orders[index], *dispatch_rule, get_processing_time(orders[index].product_id), now);
+            }
+        }
+
+        std::vector<size_t> waiting;    //Orders whose family has no free kanban card
+        bool admitted_any = false;
+        while (!released.empty() && simulation_running) {
+            int now = current_sim_time_minutes.load();
+            released.refresh(*dispatch_rule, now, [&](size_t index) {
+                return dispatch_rule->key(orders[index], get_processing_time(orders[index].product_id), now);
+            });
+            size_t index = released.top();
+            released.pop();
+            if (!try_admit((int)index)) {
+                waiting.push_back(index);
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            admit_order((int)index);
+            admitted_any = true;
+        }
+        for (size_t index : waiting) {  //Re-queue blocked orders, ranked at the current time
+            released.push(index, orders[index], *dispatch_rule, get_processing_time(orders[index].product_id),
+                          current_sim_time_minutes.load());
+        }
+
+        blocked = !released.empty() && !admitted_any;
+        if (blocked) {
+            std::unique_lock<std::mutex> lk(wip_mutex);  //Wait for an order to leave the system
+            wip_cv.wait_for(lk, std::chrono::milliseconds(100));
+        }
     }
 
-    scheduler_done = true;
+    {
+        std::lock_guard<std::mutex> lk(completion_mutex);  // Pairs with the waiter's predicate check
+        scheduler_done = true;
+    }
     completion_cv.notify_all(); // Notify in case waiting for completion <----------------------------
 }
 
 
+/**
+ * @brief Take a WIP slot and a kanban card for an order if both are free
+ * @param index Position of a customer order in orders
+ * @return true if the order may enter the system now
+ */
+bool ControlCenter::try_admit(int index) {
+    std::lock_guard<std::mutex> lk(wip_mutex);
+    const std::string& family = orders[index].product_id;
+    if (release_control_enabled()) {
+        auto cards = kanban_cards.find(family);
+        if ((conwip_cap > 0 && wip_count >= conwip_cap) ||
+            (cards != kanban_cards.end() && cards_in_use[family] >= cards->second)) {
+            admission_refused[index] = 1;
+            return false;
+        }
+    }
+    wip_count++;
+    cards_in_use[family]++;
+    max_wip = std::max(max_wip, wip_count);
+    //An order that had to wait enters when the slot it took was freed
+    shop_release_minutes[index] = admission_refused[index]
+        ? std::max(orders[index].release_time_minutes, last_exit_minutes)
+        : orders[index].release_time_minutes;
+    admitted_at[index] = std::chrono::steady_clock::now();
+    sim_metrics.wip.add(1);
+    return true;
+}
+
+
+/**
+ * @brief Admit an order into the system: its sub-assembly orders first, then itself
+ * A customer order with sub-assemblies is canceled with its whole tree when the
+ * unreserved stock cannot cover its exploded raw requirements: raw stock is never
+ * replenished, so building its sub-assemblies would only consume parts other
+ * orders need.
+ * @param index Position of the order in orders
+ */
+void ControlCenter::admit_order(int index) {
+    if (orders[index].parent_order_id < 0 && first_child[index] >= 0 && warehouse &&
+        !warehouse->has_components(bom_explosion.raw_requirements(orders[index].product_id))) {
+        FAS_LOG_INFO(this, log_event("Order " + std::to_string(orders[index].order_id) + " (" + orders[index].product_id +
+                                     ") canceled at admission: stock cannot cover its exploded BOM"));
+        cancel_order_tree(index);
+        return;
+    }
+    for (int child = first_child[index]; child >= 0; child = next_sibling[child]) {
+        admit_order(child);
+    }
+    release_when_ready(index);
+}
+
+
+/**
+ * @brief Cancel an order and all of its sub-assembly orders
+ * @param index Position of the order in orders
+ */
+void ControlCenter::cancel_order_tree(int index) {
+    for (int child = first_child[index]; child >= 0; child = next_sibling[child]) {
+        cancel_order_tree(child);
+    }
+    mark_order_canceled(orders[index].order_id);
+}
+
+
+/**
+ * @brief Return the WIP slot and kanban card of a customer order that left the system
+ * @param index Position of the order in orders
+ */
+void ControlCenter::on_order_exit(int index) {
+    if (orders[index].parent_order_id >= 0) return;
+    {
+        std::lock_guard<std::mutex> lk(wip_mutex);
+        if (shop_release_minutes[index] < 0) return;     //Never admitted (canceled while waiting)
+        wip_count--;
+        cards_in_use[orders[index].product_id]--;
+        int exit_time = orders[index].is_completed ? orders[index].completion_time_minutes : current_sim_time_minutes.load();
+        last_exit_minutes = std::max(last_exit_minutes, exit_time);
+        if (orders[index].is_completed) {
+            auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - admitted_at[index]).count();
+            sim_metrics.system_time_seconds.record((int64_t)elapsed_ms * 60 / AGV_MS_PER_MINUTE);
+        }
+    }
+    sim_metrics.wip.add(-1);
+    wip_cv.notify_all();
+}
+
+
 /**
  * @brief Release an order to the assembly station
  * @param order The order to be released
  */
 void ControlCenter::release_order(const Order& order) {
-    std::stringstream msg;
-    msg << format_time(order.release_time_minutes) 
-        << " Order released: " << order.product_id 
-        << " (Priority: " << order.priority << ", ID: " << order.order_id << ")";
-    log_event(msg.str());
+    int index = find_order(order.order_id);
+    if (index >= 0 && !transition_order(index, OrderState::PENDING, OrderState::RELEASED)) {
+        return;     //Canceled while held (e.g. a sub-assembly failed)
+    }
+    if (index >= 0) released_at[index] = std::chrono::steady_clock::now();
+    sim_metrics.orders_released.fetch_add(1, std::memory_order_relaxed);
+
+    FAS_LOG_INFO(this, log_trace(TraceEvent::ORDER_RELEASED, order.order_id));
 
     if (assembly_station) {
         assembly_station->set_simulation_time(current_sim_time_minutes.load());
@@ -210,24 +443,378 @@ void ControlCenter::release_order(const Order& order) {
 }
 
 
+/**
+ * @brief Build the dense order_id -> position index and reset order states
+ * When streaming, orders and every per-order array are sized for
+ * order_capacity orders up front, so append_order() fills spare slots in place
+ * and never moves one another thread is reading. Streamed customer IDs lie
+ * below customer_id_limit and their sub-assembly IDs above it.
+ */
+void ControlCenter::build_order_index() {
+    int max_id = 0;
+    for (const auto& order : orders) { max_id = std::max(max_id, order.order_id); }
+    size_t loaded = orders.size();
+    size_t slots = std::max(loaded, order_capacity);
+    orders.resize(slots);
+    customer_id_limit = max_id + 1 + (int)(slots - loaded);
+    order_index.assign(customer_id_limit + (slots - loaded), -1);
+    order_states.reset(new std::atomic<uint8_t>[slots]);
+    release_holds.reset(new std::atomic<int>[slots]);
+    agv_trips.reset(new std::atomic<int>[slots]);
+    first_child.assign(slots, -1);
+    next_sibling.assign(slots, -1);
+    shop_release_minutes.assign(slots, -1);
+    admission_refused.assign(slots, 0);
+    admitted_at.assign(slots, std::chrono::steady_clock::time_point());
+    order_records.assign(slots, OrderRecord());
+    released_at.assign(slots, std::chrono::steady_clock::time_point());
+    for (size_t i = 0; i < loaded; ++i) { index_order(i); }
+    link_subassembly_orders(0, loaded);
+    next_customer_id = max_id + 1;
+    next_subassembly_id = customer_id_limit;
+    order_count = (int)loaded;
+    wip_count = 0; max_wip = 0; last_exit_minutes = 0; cards_in_use.clear();
+}
+
+
+/**
+ * @brief Enter one order into the ID index and reset its state
+ * @param index Position of the order in orders
+ */
+void ControlCenter::index_order(size_t index) {
+    if (orders[index].order_id >= 0) order_index[orders[index].order_id] = (int)index;
+    order_states[index].store(static_cast<uint8_t>(OrderState::PENDING), std::memory_order_relaxed);
+    release_holds[index].store(1, std::memory_order_relaxed);   //Own release event
+    agv_trips[index].store(0, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Link the sub-assembly orders in [first, last) to their parents
+ * @param first Position of the first order to link
+ * @param last One past the last position
+ */
+void ControlCenter::link_subassembly_orders(size_t first, size_t last) {
+    for (size_t i = last; i-- > first;) {   //Reverse pass keeps siblings in input order
+        int parent = find_order(orders[i].parent_order_id);
+        if (parent < 0) continue;
+        release_holds[parent].fetch_add(1, std::memory_order_relaxed);
+        next_sibling[i] = first_child[parent];
+        first_child[parent] = (int)i;
+    }
+}
+
+
+/**
+ * @brief Generate sub-assembly orders for every order whose product has sub-assemblies
+ * Child orders inherit the release time and priority, are due before their parent
+ * can start, and are appended after the customer orders with fresh IDs.
+ */
+void ControlCenter::expand_subassembly_orders() {
+    if (!bom_explosion.has_subassemblies()) return;
+    int next_order_id = 1;
+    for (const auto& order : orders) { next_order_id = std::max(next_order_id, order.order_id + 1); }
+    size_t customer_orders = orders.size();
+    std::vector<Order> generated;
+    for (size_t i = 0; i < customer_orders; ++i) {
+        if (orders[i].parent_order_id >= 0) continue;   //Already expanded
+        expand_order(orders[i], next_order_id, generated);
+    }
+    orders.insert(orders.end(), generated.begin(), generated.end());
+}
+
+
+/**
+ * @brief Generate the sub-assembly orders of one customer order
+ * @param parent The customer order
+ * @param next_order_id Next free order ID (advanced for each generated order)
+ * @param generated Receives the sub-assembly orders
+ */
+void ControlCenter::expand_order(const Order& parent, int& next_order_id, std::vector<Order>& generated) {
+    int count = add_subassembly_orders(parent, next_order_id, generated);
+    if (count > 0) {
+        FAS_LOG_INFO(this, log_event("Order " + std::to_string(parent.order_id) + " (" + parent.product_id + ", BOM level " +
+                                     std::to_string(bom_explosion.level(parent.product_id)) + ") expanded into " +
+                                     std::to_string(count) + " sub-assembly order(s)"));
+    }
+}
+
+
+/**
+ * @brief Recursively generate the sub-assembly orders of one order
+ * @param parent The order consuming the sub-assemblies
+ * @param next_order_id Next free order ID (advanced for each generated order)
+ * @param generated Receives the sub-assembly orders, parents before children
+ * @return Number of orders generated (all levels)
+ */
+int ControlCenter::add_subassembly_orders(const Order& parent, int& next_order_id, std::vector<Order>& generated) {
+    int count = 0;
+    for (const auto& child : bom_explosion.subassemblies(parent.product_id)) {
+        for (int unit = 0; unit < child.second; ++unit) {
+            Order sub = parent;
+            sub.order_id = next_order_id++;
+            sub.product_id = child.first;
+            sub.parent_order_id = parent.order_id;
+            if (parent.due_date_minutes >= 0) {     //Must be done before the parent is assembled
+                sub.due_date_minutes = parent.due_date_minutes - get_processing_time(parent.product_id);
+            }
+            generated.push_back(sub);
+            count += 1 + add_subassembly_orders(sub, next_order_id, generated);
+        }
+    }
+    return count;
+}
+
+
+/**
+ * @brief Number of sub-assembly orders one order of a product generates (all levels)
+ * @param product_id The product of the order
+ */
+int ControlCenter::count_subassembly_orders(const std::string& product_id) const {
+    int count = 0;
+    for (const auto& child : bom_explosion.subassemblies(product_id)) {
+        count += child.second * (1 + count_subassembly_orders(child.first));
+    }
+    return count;
+}
+
+
+/**
+ * @brief Add a streamed customer order and its sub-assembly orders to the running pipeline
+ * Called by the scheduler thread only. The order keeps the feed's ID (id=N)
+ * or takes the next free one. The new orders are written into spare slots
+ * before order_count publishes them; orders itself never grows.
+ * @param order The parsed order (order_id 0 = no ID in the feed)
+ * @return Position of the order in orders, -1 if order_capacity is reached,
+ *         -2 if its ID is out of range or already used (the order is dropped)
+ */
+int ControlCenter::append_order(Order order) {
+    size_t first = (size_t)order_count.load(std::memory_order_relaxed);    //Only this thread changes it
+    size_t last = first + 1 + count_subassembly_orders(order.product_id);
+    if (last > orders.size()) return -1;
+    if (order.order_id <= 0) {
+        while (find_order(next_customer_id) >= 0) ++next_customer_id;
+        order.order_id = next_customer_id++;
+    }
+    if (order.order_id >= customer_id_limit || find_order(order.order_id) >= 0) {
+        std::cerr << "Warning: streamed order ID " << order.order_id << " is "
+                  << (order.order_id >= customer_id_limit ? "out of range" : "already used") << ", order ignored" << std::endl;
+        return -2;
+    }
+    std::vector<Order> generated;
+    expand_order(order, next_subassembly_id, generated);
+    orders[first] = std::move(order);
+    std::move(generated.begin(), generated.end(), orders.begin() + first + 1);
+    for (size_t i = first; i < last; ++i) {
+        index_order(i);
+        TraceOrderName name;
+        name.order_id = orders[i].order_id;
+        name.priority = orders[i].priority;
+        name.release_minutes = orders[i].release_time_minutes;
+        name.product_id = orders[i].product_id;
+        trace_names.add_order(name);
+    }
+    link_subassembly_orders(first, last);
+    order_count.store((int)last);
+    return (int)first;
+}
+
+
+/**
+ * @brief Move orders that arrived on the stream into the release event queue
+ * Only as many orders as the stream queue holds are taken ahead of admission,
+ * so a CONWIP-blocked scheduler stops draining the stream (backpressure).
+ * @param release_events Scheduler release events
+ * @param released_waiting Orders released but not yet admitted
+ * @return false once the stream has ended and every order was taken
+ */
+bool ControlCenter::ingest_streamed_orders(ReleaseQueue& release_events, size_t released_waiting) {
+    size_t waiting = release_events.size() + released_waiting;
+    size_t room = order_stream->capacity() > waiting ? order_stream->capacity() - waiting : 0;
+    std::vector<Order> arrivals;
+    order_stream->pop(arrivals, room);
+    for (auto& order : arrivals) {
+        int index = append_order(std::move(order));
+        if (index == -2) continue;
+        if (index < 0) {
+            std::cerr << "Warning: order capacity (" << order_capacity << ") reached, closing " << order_stream->path() << std::endl;
+            order_stream->close();
+            return false;
+        }
+        release_events.push(ReleaseEvent{orders[index].release_time_minutes, (size_t)index});
+    }
+    if (!order_stream->finished()) return true;
+    FAS_LOG_INFO(this, log_event("Order stream ended: " + std::to_string(order_stream->orders_read()) +
+                                 " order(s) read from " + order_stream->path()));
+    return false;
+}
+
+
+/**
+ * @brief Count down the release holds of an order and release it at zero
+ * An order is held by its own release event and by each child sub-assembly
+ * order until that child's unit is back in stock.
+ * @param index Position of the order in orders
+ */
+void ControlCenter::release_when_ready(int index) {
+    if (index < 0) return;
+    if (release_holds[index].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        release_order(orders[index]);
+    }
+}
+
+
+/**
+ * @brief Find the position of an order in O(1)
+ * @param order_id The ID of the order
+ * @return Position in orders, or -1 if unknown
+ */
+int ControlCenter::find_order(int order_id) const {
+    if (order_id < 0 || order_id >= (int)order_index.size()) return -1;
+    return order_index[order_id];
+}
+
+
+/**
+ * @brief Per-order result slot of an order
+ * @param order_id The ID of the order
+ * @return The record, or nullptr if the order is unknown
+ */
+OrderRecord* ControlCenter::find_record(int order_id) {
+    int index = find_order(order_id);
+    return (index >= 0 && index < (int)order_records.size()) ? &order_records[index] : nullptr;
+}
+
+
+/**
+ * @brief Current simulated time of an order on the AGV clock
+ * @param index Position of the order in orders
+ * @return Release time plus the AGV-scaled wall time since the order reached the station
+ */
+int ControlCenter::agv_clock_minutes(int index) const {
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - released_at[index]).count();
+    return orders[index].release_time_minutes + (int)(elapsed_ms / AGV_MS_PER_MINUTE);
+}
+
+
+/**
+ * @brief Record that an order's components were reserved and requested
+ * @param order_id The ID of the order
+ */
+void ControlCenter::record_order_staged(int order_id) {
+    if (OrderRecord* record = find_record(order_id)) record->staged = agv_clock_minutes(find_order(order_id));
+}
+
+
+/**
+ * @brief Record that the last component unit of an order's kit was delivered
+ * @param order_id The ID of the order
+ */
+void ControlCenter::record_order_kitted(int order_id) {
+    if (OrderRecord* record = find_record(order_id)) record->kitted = agv_clock_minutes(find_order(order_id));
+}
+
+
+/**
+ * @brief Record the line, start time and setup of an order picked by an assembly line
+ * @param order_id The ID of the order
+ * @param line_id Assembly line index
+ * @param start_minutes Start time in line virtual minutes
+ * @param setup_minutes Setup applied before assembly
+ */
+void ControlCenter::record_order_started(int order_id, int line_id, int start_minutes, int setup_minutes) {
+    if (OrderRecord* record = find_record(order_id)) {
+        record->line = line_id;
+        record->start = start_minutes;
+        record->setup_minutes = setup_minutes;
+    }
+}
+
+
+/**
+ * @brief Count one AGV trip made for an order
+ * @param order_id The ID of the order
+ */
+void ControlCenter::record_agv_trip(int order_id) {
+    int index = find_order(order_id);
+    if (index >= 0 && agv_trips) agv_trips[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Atomically move an order from one state to another
+ * @param index Position of the order in orders
+ * @param from_state Expected current state
+ * @param to_state New state
+ * @return true if this call performed the transition
+ */
+bool ControlCenter::transition_order(int index, OrderState from_state, OrderState to_state) {
+    uint8_t expected = static_cast<uint8_t>(from_state);
+    return order_states[index].compare_exchange_strong(expected, static_cast<uint8_t>(to_state),
+                                                       std::memory_order_acq_rel);
+}
+
+
+/**
+ * @brief Get the lifecycle state of an order
+ * @param order_id The ID of the order
+ * @return The order state (PENDING if unknown)
+ */
+OrderState ControlCenter::get_order_state(int order_id) const {
+    int index = find_order(order_id);
+    if (index < 0 || !order_states) return OrderState::PENDING;
+    return static_cast<OrderState>(order_states[index].load(std::memory_order_acquire));
+}
+
+
+/**
+ * @brief Check whether an order was generated for a sub-assembly
+ * @param order_id The ID of the order
+ * @return true if the order feeds a parent order
+ */
+bool ControlCenter::is_subassembly_order(int order_id) const {
+    int index = find_order(order_id);
+    return index >= 0 && orders[index].parent_order_id >= 0;
+}
+
+
 /**
  * @brief Mark an order as completed
  * @param order_id The ID of the completed order
  * @param completion_time_minutes The completion time in minutes
  */
 void ControlCenter::mark_order_completed(int order_id, int completion_time_minutes) {
-    for (auto& order : orders) {
-        if (order.order_id == order_id) {
-            order.is_completed = true; order.completion_time_minutes = completion_time_minutes;
-            {
-                std::lock_guard<std::mutex> lk(completion_mutex); // Lock for updating completed orders <------------------------------
-                completed_orders.fetch_add(1);
-            }
-            completion_cv.notify_all(); // Notify in case waiting for completion <------------------------------
-            std::stringstream msg; msg << format_time(completion_time_minutes) << " Order completed: " << order.product_id << " (ID: " << order_id << ")"; log_event(msg.str());
-            break;
-        }
+    int index = find_order(order_id);
+    if (index < 0) return;
+    if (!transition_order(index, OrderState::RELEASED, OrderState::COMPLETED) &&
+        !transition_order(index, OrderState::PENDING, OrderState::COMPLETED)) {
+        return;     //Already completed or canceled
+    }
+    Order& order = orders[index];   //Only the thread that won the transition writes this slot
+    order.is_completed = true; order.completion_time_minutes = completion_time_minutes;
+    sim_metrics.orders_completed.fetch_add(1, std::memory_order_relaxed);
+    if (order.parent_order_id < 0) {
+        sim_metrics.lead_time_minutes.record(completion_time_minutes - order.release_time_minutes);
     }
+    on_order_exit(index);   //A sub-assembly's parent is released once the unit is back in stock
+    if (completed_orders.fetch_add(1) + 1 == order_count.load()) {  // Only the last order wakes the waiter
+        { std::lock_guard<std::mutex> lk(completion_mutex); } // Pairs with the waiter's predicate check <------------------------------
+        completion_cv.notify_all();
+    }
+    FAS_LOG_INFO(this, log_trace(TraceEvent::ORDER_COMPLETED, order_id, -1, -1, completion_time_minutes));
+}
+
+
+/**
+ * @brief A finished sub-assembly unit is back in component stock
+ * Its parent is released only when every child unit has arrived, so the
+ * parent's reservation finds them on the shelf.
+ * @param order_id The sub-assembly order that produced the unit
+ */
+void ControlCenter::mark_subassembly_stocked(int order_id) {
+    int index = find_order(order_id);
+    if (index < 0) return;
+    release_when_ready(find_order(orders[index].parent_order_id));
 }
 
 
@@ -236,42 +823,104 @@ void ControlCenter::mark_order_completed(int order_id, int completion_time_minut
  * @param order_id The ID of the canceled order
  */
 void ControlCenter::mark_order_canceled(int order_id) {
-    for (auto& order : orders) {
-        if (order.order_id == order_id) {
-            order.is_canceled = true;
-            {
-                std::lock_guard<std::mutex> lk(completion_mutex); // Lock for updating completed orders <------------------------------
-                completed_orders.fetch_add(1);
-            }
-            completion_cv.notify_all(); // Notify in case waiting for completion <---------after all orders are done---
-            std::stringstream msg; msg << format_time(current_sim_time_minutes.load())
-                << " Order canceled: " << order.product_id << " (ID: " << order_id << ")";
-            log_event(msg.str());
-            break;
-        }
+    int index = find_order(order_id);
+    if (index < 0) return;
+    if (!transition_order(index, OrderState::RELEASED, OrderState::CANCELED) &&
+        !transition_order(index, OrderState::PENDING, OrderState::CANCELED)) {
+        return;     //Already completed or canceled
+    }
+    Order& order = orders[index];
+    order.is_canceled = true;
+    sim_metrics.orders_canceled.fetch_add(1, std::memory_order_relaxed);
+    on_order_exit(index);
+    if (completed_orders.fetch_add(1) + 1 == order_count.load()) {  // Only the last order wakes the waiter
+        { std::lock_guard<std::mutex> lk(completion_mutex); } // Pairs with the waiter's predicate check <------------------------------
+        completion_cv.notify_all();
+    }
+    FAS_LOG_INFO(this, log_trace(TraceEvent::ORDER_CANCELED, order_id));
+    if (order.parent_order_id >= 0) {
+        mark_order_canceled(order.parent_order_id);     //A parent cannot be built without its sub-assembly
     }
 }
 
 
+/**
+ * @brief Summarize a histogram into count, p50/p90/p99 and max
+ * @param histogram Source histogram (shared by all recording threads)
+ * @param scale Factor converting recorded units into minutes
+ */
+static PercentileSummary summarize(const HdrHistogram& histogram, double scale) {
+    PercentileSummary summary;
+    summary.count = (long long)histogram.count();
+    summary.p50 = histogram.value_at_percentile(50.0) * scale;
+    summary.p90 = histogram.value_at_percentile(90.0) * scale;
+    summary.p99 = histogram.value_at_percentile(99.0) * scale;
+    summary.max = histogram.max() * scale;
+    return summary;
+}
+
+
+/**
+ * @brief Time-weighted queue statistics with a Little's-law cross-check
+ * @param name Queue name in the report
+ * @param gauge Queue length gauge
+ * @param sojourn Time spent in the queue (simulated seconds), or nullptr if not measured
+ */
+static QueueStats queue_stats(const std::string& name, const TimeWeightedGauge& gauge, const HdrHistogram* sojourn) {
+    QueueStats stats;
+    stats.name = name;
+    uint64_t entries = 0; double elapsed_ms = 0.0;
+    gauge.snapshot(stats.avg_length, stats.max_length, entries, elapsed_ms);
+    double elapsed_minutes = elapsed_ms / AGV_MS_PER_MINUTE;
+    if (elapsed_minutes > 0) stats.arrivals_per_hour = entries * 60.0 / elapsed_minutes;
+    if (sojourn && sojourn->count() > 0) {
+        stats.mean_time_minutes = sojourn->mean() / 60.0;
+        stats.little_length = stats.arrivals_per_hour / 60.0 * stats.mean_time_minutes;    //L = lambda x W
+    }
+    return stats;
+}
+
+
 /**
  * @brief Compute KPIs at the end of the simulation
  */
 void ControlCenter::compute_kpis() {
     if (orders.empty()) return;
 
+    KpiReport kpis;
     double total_lead_time = 0.0; int completed_count = 0; int max_completion_time = 0;
-    int canceled_count = 0;
-    for (const auto& order : orders) {
+    int canceled_count = 0; long long total_tardiness = 0; int subassembly_count = 0;
+    double total_shop_time = 0.0;       //Sum of admitted-to-completed times (WIP integral)
+    for (size_t i = 0; i < orders.size(); ++i) {  //Single pass: lead time, makespan, WIP and due-date KPIs
+        const Order& order = orders[i];
+        if (order.parent_order_id >= 0) { subassembly_count++; continue; }  //Internal work, not a customer order
         if (order.is_canceled) { canceled_count++; continue; }
         if (order.is_completed) {
             int lead_time = order.completion_time_minutes - order.release_time_minutes;
             total_lead_time += lead_time; completed_count++;
+            if (i < shop_release_minutes.size() && shop_release_minutes[i] >= 0) {
+                total_shop_time += std::max(0, order.completion_time_minutes - shop_release_minutes[i]);
+            }
             if (order.completion_time_minutes > max_completion_time) max_completion_time = order.completion_time_minutes;
+            if (order.due_date_minutes >= 0) {
+                int lateness = order.completion_time_minutes - order.due_date_minutes;
+                kpis.orders_with_due_date++;
+                kpis.lateness.add(lateness);
+                if (lateness > 0) {
+                    kpis.late_orders++; total_tardiness += lateness;
+                    kpis.max_tardiness = std::max(kpis.max_tardiness, lateness);
+                }
+            }
         }
     }
+    if (kpis.orders_with_due_date > 0) {
+        kpis.mean_tardiness = (double)total_tardiness / kpis.orders_with_due_date;
+        kpis.percent_late = 100.0 * kpis.late_orders / kpis.orders_with_due_date;
+    }
 
     double avg_lead_time = (completed_count > 0) ? (total_lead_time / completed_count) : 0.0;
-    int first_release_time = orders.empty() ? 0 : orders[0].release_time_minutes;
+    int first_release_time = orders[0].release_time_minutes;
+    for (const auto& order : orders) { first_release_time = std::min(first_release_time, order.release_time_minutes); }
     int total_sim_time = max_completion_time - first_release_time;
     if (total_sim_time <= 0) { total_sim_time = current_sim_time_minutes.load(); if (total_sim_time <= 0) total_sim_time = 1; }
 
@@ -283,14 +932,16 @@ void ControlCenter::compute_kpis() {
     if (agv_fleet) { for (auto* agv : *agv_fleet) { total_agv_busy_time += agv->busy_time_minutes.load(); } }
     double agv_utilization = (double)total_agv_busy_time / (num_agvs * total_sim_time);
 
-    if (enable_diag_logs) {
+#if FAS_LOG_LEVEL >= FAS_LOG_LEVEL_DIAG
+    if (log_enabled(LogLevel::DIAG)) {
         std::stringstream diag;
         diag << "[Diag] totals: total_agv_busy_time=" << total_agv_busy_time
              << ", num_agvs=" << num_agvs
              << ", total_sim_time=" << total_sim_time
              << ", station_busy_time=" << station_busy_time
              << ", completed_count=" << completed_count
-             << ", canceled_count=" << canceled_count;
+             << ", canceled_count=" << canceled_count
+             << ", subassembly_orders=" << subassembly_count;
         log_event(diag.str());
         if (agv_fleet) {
             for (auto* agv : *agv_fleet) {
@@ -302,20 +953,72 @@ void ControlCenter::compute_kpis() {
             }
         }
     }
+#endif
 
-    write_kpi_report(avg_lead_time, station_utilization, throughput, agv_utilization);
+    kpis.avg_lead_time = avg_lead_time;
+    kpis.station_utilization = station_utilization;
+    kpis.throughput = throughput;
+    kpis.agv_utilization = agv_utilization;
+    kpis.lead_time = summarize(sim_metrics.lead_time_minutes, 1.0);
+    kpis.queue_wait = summarize(sim_metrics.queue_wait_seconds, 1.0 / 60);
+    kpis.kit_preparation = summarize(sim_metrics.kit_prep_seconds, 1.0 / 60);
+    kpis.agv_response = summarize(sim_metrics.agv_response_seconds, 1.0 / 60);
+    kpis.conwip_cap = conwip_cap;
+    kpis.avg_wip = total_shop_time / total_sim_time;   //Little's law: WIP = throughput x flow time
+    kpis.max_wip = max_wip;
+    kpis.queues.push_back(queue_stats("Order queue", sim_metrics.order_queue, nullptr));
+    kpis.queues.push_back(queue_stats("Kits in staging", sim_metrics.staging_orders, &sim_metrics.kit_prep_seconds));
+    kpis.queues.push_back(queue_stats("Undelivered units", sim_metrics.pending_units, nullptr));
+    kpis.queues.push_back(queue_stats("Ready queue", sim_metrics.ready_queue, &sim_metrics.queue_wait_seconds));
+    kpis.queues.push_back(queue_stats("WIP (admitted)", sim_metrics.wip, &sim_metrics.system_time_seconds));
+    kpi_report = kpis;
+    write_kpi_report(kpis);
 }
 
 
 /**
  * @brief Write KPI report to file
- * @param avg_lead_time Average lead time
- * @param station_utilization Station utilization
- * @param throughput Throughput
- * @param agv_utilization AGV utilization
+ * @param kpis KPI values of the run
+ */
+void ControlCenter::write_kpi_report(const KpiReport& kpis) {
+    if (!kpi_report_file.empty()) FileHandler::write_kpi_report(kpi_report_file, kpis);
+    if (!kpi_json_file.empty()) FileHandler::write_kpi_json(kpi_json_file, kpis);
+    write_order_results();
+}
+
+
+/**
+ * @brief Choose where the end-of-run reports go
+ * @param kpi_report Text KPI report ("" = not written)
+ * @param kpi_json KPI JSON ("" = not written)
+ * @param order_results Per-order CSV ("" = not written)
  */
-void ControlCenter::write_kpi_report(double avg_lead_time, double station_utilization, double throughput, double agv_utilization) {
-    FileHandler::write_kpi_report("output/kpi_report.txt", avg_lead_time, station_utilization, throughput, agv_utilization);
+void ControlCenter::set_report_files(const std::string& kpi_report, const std::string& kpi_json,
+                                     const std::string& order_results) {
+    kpi_report_file = kpi_report;
+    kpi_json_file = kpi_json;
+    order_results_file = order_results;
+}
+
+
+/**
+ * @brief Fill the per-order results and write one CSV row per order (customer and sub-assembly orders)
+ */
+void ControlCenter::write_order_results() {
+    order_records.resize(std::min(order_records.size(), orders.size()));   //Drop unused streaming slots
+    for (size_t i = 0; i < orders.size() && i < order_records.size(); ++i) {
+        const Order& order = orders[i];
+        OrderRecord& record = order_records[i];
+        record.order_id = order.order_id;
+        record.product_id = order.product_id;
+        record.parent_order_id = order.parent_order_id;
+        record.status = order.is_completed ? "completed" : (order.is_canceled ? "canceled" : "pending");
+        record.release = order.release_time_minutes;
+        record.due_date = order.due_date_minutes;
+        record.completion = order.is_completed ? order.completion_time_minutes : -1;
+        record.agv_trips = agv_trips[i].load(std::memory_order_relaxed);
+    }
+    if (!order_results_file.empty()) FileHandler::write_order_csv(order_results_file, order_records);
 }
 
 
@@ -324,18 +1027,91 @@ void ControlCenter::write_kpi_report(double avg_lead_time, double station_utiliz
  * @param message The message to log
  */
 void ControlCenter::log_event(const std::string& message) {
-    std::lock_guard<std::mutex> lock(log_mutex);  // Lock for logging (signal safety) <-----interleaving-------------------------
-    std::string time_str = format_time(current_sim_time_minutes.load());
-    if (log_file.is_open()) { log_file << time_str << " " << message << std::endl; log_file.flush(); } // Flush to ensure log is written promptly
-    std::cout << time_str << " " << message << std::endl;
+    if (event_trace.is_open()) {
+        event_trace.append_text(current_sim_time_minutes.load(), message);
+        return;
+    }
+    logger.log(current_sim_time_minutes.load(), message);  // Formatting and I/O happen on the writer thread
+}
+
+
+/**
+ * @brief Log a typed event: one binary record when tracing, otherwise its text form
+ * @param type The event
+ * @param order_id Order concerned (-1 if none)
+ * @param agv_id AGV concerned (-1 if none)
+ * @param component Warehouse component index (-1 if none)
+ * @param value Event-specific value (see TraceEvent)
+ */
+void ControlCenter::log_trace(TraceEvent type, int order_id, int agv_id, int component, int value) {
+    TraceRecord record{current_sim_time_minutes.load(), static_cast<uint16_t>(type), 0, order_id, agv_id, component, value};
+    if (event_trace.is_open()) {
+        event_trace.append(record);
+        return;
+    }
+    logger.log(record.sim_minutes, format_trace_event(record, trace_names));
+}
+
+
+/**
+ * @brief Write events to a binary trace instead of the text log and console
+ * Decode it with: fas_simulator decode-trace
+ * @param filename Path of the trace file
+ * @return true if the trace file was created
+ */
+bool ControlCenter::enable_event_trace(const std::string& filename) {
+    return event_trace.open(filename);
+}
+
+
+/**
+ * @brief Set the runtime log level
+ * Messages above the level are neither formatted nor written.
+ * @param level Highest level logged
+ */
+void ControlCenter::set_log_level(LogLevel level) {
+    log_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Snapshot the component and order names that typed events refer to
+ */
+void ControlCenter::build_trace_names() {
+    trace_names.components.clear();
+    int component_count = warehouse ? warehouse->component_count() : 0;
+    for (int i = 0; i < component_count; ++i) trace_names.components.push_back(warehouse->component_name(i));
+    trace_names.orders.clear();
+    for (int i = 0; i < order_count.load(); ++i) {
+        const Order& order = orders[i];
+        TraceOrderName name;
+        name.order_id = order.order_id;
+        name.priority = order.priority;
+        name.release_minutes = order.release_time_minutes;
+        name.product_id = order.product_id;
+        trace_names.orders.push_back(name);
+    }
+    trace_names.index_orders();
+    trace_names.reserve_orders(orders.size(), (int)order_index.size() - 1);   //Streamed orders
+}
+
+/**
+ * @brief Get the processing time of a product (base assembly time)
+ * @param product_id The ID of the product
+ * @return Processing time in minutes
+ */
+int ControlCenter::get_processing_time(const std::string& product_id) const {
+    auto it = products.find(product_id);
+    return (it != products.end()) ? it->second.base_assembly_time_minutes : 30;
 }
 
 /**
- * @brief Format time in minutes to HH:MM string
- * @param minutes Time in minutes
- * @return Formatted time string
+ * @brief Average processing time over all loaded orders
+ * @return Mean processing time in minutes (30 when no orders are loaded)
  */
-std::string ControlCenter::format_time(int minutes) const {
-    int hours = minutes / 60; int mins = minutes % 60; std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << hours << ":" << std::setfill('0') << std::setw(2) << mins; return ss.str();
+double ControlCenter::mean_processing_time() const {
+    if (orders.empty()) return 30.0;
+    double total = 0.0;
+    for (const auto& order : orders) { total += get_processing_time(order.product_id); }
+    return total / orders.size();
 }
@@ -10,6 +10,16 @@
 #include "Order.h"
 #include "Product.h"
 #include "Warehouse.h"
+#include "DispatchRule.h"
+#include "KpiReport.h"
+#include "BomExplosion.h"
+#include "Metrics.h"
+#include "AsyncLogger.h"
+#include "EventTrace.h"
+#include "SimTimeline.h"
+#include "LogLevel.h"
+#include "OrderStream.h"
+#include "ScenarioImage.h"
 
 /**************************************************************************************/
 
@@ -19,24 +29,33 @@ class AssemblyStation;
 class AGV;
 #include <vector>
 #include <map>
+#include <memory>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <fstream>
 #include <condition_variable>
+#include <queue>
+#include <functional>
 
 /*************************************************************************************/
 
 /**
- * @enum SchedulingPolicy
- * @brief Enumeration of scheduling policies
+ * @struct ReleaseEvent
+ * @brief Scheduled order release, ordered by time then input position
  */
-enum class SchedulingPolicy {
-    FIFO,
-    PRIORITY,
-    SPT,
-    EDD
+struct ReleaseEvent {
+    int time_minutes;
+    size_t order_index;
+
+    bool operator>(const ReleaseEvent& other) const {
+        if (time_minutes != other.time_minutes) return time_minutes > other.time_minutes;
+        return order_index > other.order_index;
+    }
 };
+typedef std::priority_queue<ReleaseEvent, std::vector<ReleaseEvent>, std::greater<ReleaseEvent>> ReleaseQueue;
 
 /**
  * @class ControlCenter
@@ -44,42 +63,105 @@ enum class SchedulingPolicy {
  */
 class ControlCenter {
 private:
-    std::vector<Order> orders;
+    std::vector<Order> orders;                          // Sized once at start; slots [0, order_count) are in use
+    std::vector<int> order_index;                       // order_id -> position in orders (-1 if unknown)
+    std::unique_ptr<std::atomic<uint8_t>[]> order_states; // OrderState per position in orders
     std::map<std::string, Product> products;
+    BomExplosion bom_explosion;                         // Multi-level BOM (sub-assemblies)
+    std::unique_ptr<std::atomic<int>[]> release_holds;  // Release event + sub-assemblies not yet in stock per position
+    std::vector<int> first_child;                       // First sub-assembly order per position (-1 = none)
+    std::vector<int> next_sibling;                      // Next sub-assembly order of the same parent
+    std::vector<int> shop_release_minutes;              // Time each customer order was admitted (-1 = not yet)
     AssemblyStation* assembly_station;
+    Warehouse* warehouse;                           // Set by load_warehouse; owns component indices
     std::vector<AGV*>* agv_fleet;
     
     SchedulingPolicy policy;
+    std::unique_ptr<DispatchRule> dispatch_rule;    // Release-level dispatch rule for the policy
     std::atomic<int> current_sim_time_minutes;      // Current simulation time in minutes
     std::atomic<bool> simulation_running;           // Flag indicating if simulation is running
     std::atomic<bool> has_stopped;                  // Flag indicating if simulation has stopped
     std::thread scheduler_thread;                   // Thread for scheduling orders
-    std::mutex log_mutex;                           // Mutex for logging (signal safety)
-    std::ofstream log_file;                         // Log file stream  
+    AsyncLogger logger;                             // Lock-free log queue + writer thread
+    EventTrace event_trace;                         // Binary trace; replaces the text log when open
+    TraceNames trace_names;                         // Names used to print typed events
+    SimTimeline timeline;                           // AGV/line spans for the Chrome trace export
+    std::string timeline_file;                      // Chrome trace output ("" = not recorded)
+    std::string kpi_report_file;                    // Report outputs ("" = not written)
+    std::string kpi_json_file;
+    std::string order_results_file;
+    KpiReport kpi_report;                           // KPIs of the finished run
 
     // Completion coordination
     std::mutex completion_mutex;                    // Mutex for order completion tracking (signal safety)
     std::condition_variable completion_cv;          // Condition variable for order completion
     std::atomic<int> completed_orders;              // Count of completed orders
     std::atomic<bool> scheduler_done;               // Flag indicating if scheduler is done
+    std::atomic<int> order_count;                   // Orders in the pipeline; published after their slots are filled
+
+    // Streaming ingestion: orders arrive while the simulation runs
+    std::unique_ptr<OrderStream> order_stream;      // nullptr = all orders loaded up front
+    size_t order_capacity;                          // Order slots sized before the threads start
+    int next_customer_id;                           // Next free ID for a streamed order without id=N
+    int customer_id_limit;                          // Streamed customer IDs are below this
+    int next_subassembly_id;                        // Streamed sub-assembly IDs start at customer_id_limit
+
+    std::atomic<int> log_level;                     // LogLevel; messages above it are not formatted
+    SimMetrics sim_metrics;                         // Hot-path histograms (relaxed atomics)
 
-    bool enable_diag_logs;
+    // CONWIP / kanban release control (cap 0 and no cards = release on timestamp only)
+    int conwip_cap;                                 // Max customer orders in the system
+    std::map<std::string, int> kanban_cards;        // Product family -> card count
+    std::map<std::string, int> cards_in_use;        // Product family -> admitted orders in the system
+    int wip_count;                                  // Admitted customer orders not yet completed/canceled
+    int max_wip;
+    int last_exit_minutes;                          // Sim time the latest order left the system
+    std::vector<char> admission_refused;            // Per position: refused at least once by CONWIP
+    std::vector<std::chrono::steady_clock::time_point> admitted_at; // Per position: wall time of admission
+
+    // Per-order results (per position; each field is written by one stage of the pipeline)
+    std::vector<OrderRecord> order_records;
+    std::unique_ptr<std::atomic<int>[]> agv_trips;  // Per position: trips counted by staging and line threads
+    std::vector<std::chrono::steady_clock::time_point> released_at;  // Wall time each order reached the station
+    std::mutex wip_mutex;
+    std::condition_variable wip_cv;                 // Signaled when an order leaves the system
 
     void scheduler_loop();
     void release_order(const Order& order);
+    void build_order_index();
+    void index_order(size_t index);
+    void link_subassembly_orders(size_t first, size_t last);
+    void expand_subassembly_orders();
+    void expand_order(const Order& parent, int& next_order_id, std::vector<Order>& generated);
+    int add_subassembly_orders(const Order& parent, int& next_order_id, std::vector<Order>& generated);
+    int count_subassembly_orders(const std::string& product_id) const;
+    int append_order(Order order);
+    bool ingest_streamed_orders(ReleaseQueue& release_events, size_t released_waiting);
+    void release_when_ready(int index);
+    void admit_order(int index);
+    void cancel_order_tree(int index);
+    bool try_admit(int index);
+    void on_order_exit(int index);
+    bool release_control_enabled() const { return conwip_cap > 0 || !kanban_cards.empty(); }
+    int find_order(int order_id) const;
+    bool transition_order(int index, OrderState from_state, OrderState to_state);
     void compute_kpis();
-    void write_kpi_report(double avg_lead_time,
-                          double station_utilization,
-                          double throughput,
-                          double agv_utilization);
-    std::string format_time(int minutes) const;
+    void write_kpi_report(const KpiReport& kpis);
+    void write_order_results();
+    int agv_clock_minutes(int index) const;
+    OrderRecord* find_record(int order_id);
+    void build_trace_names();
+    int get_processing_time(const std::string& product_id) const;
+    double mean_processing_time() const;
 public:
-    ControlCenter();
+    explicit ControlCenter(const std::string& log_file = "output/sim_log.txt");
     ~ControlCenter();
 
     bool load_orders(const std::string& filename);
     bool load_bom(const std::string& filename);
-    bool load_warehouse(const std::string& filename, Warehouse* warehouse);
+    bool load_warehouse(const std::string& filename, Warehouse* wh);
+    bool load_scenario(const ScenarioImage& image, Warehouse* wh);
+    bool stream_orders(const std::string& path, bool follow, size_t capacity);
 
     void start_simulation(AssemblyStation* station, std::vector<AGV*>* fleet);
     void stop_simulation();
@@ -87,16 +169,38 @@ public:
     
     void mark_order_completed(int order_id, int completion_time_minutes);
     void mark_order_canceled(int order_id);
+    void mark_subassembly_stocked(int order_id);
     void wait_until_all_orders_complete();
     
     std::vector<Order>& get_orders() { return orders; }
+    OrderState get_order_state(int order_id) const;
+    bool is_subassembly_order(int order_id) const;
     std::map<std::string, Product>& get_products() { return products; }
+    const KpiReport& get_kpis() const { return kpi_report; }                         // Valid after stop_simulation
+    const std::vector<OrderRecord>& get_order_records() const { return order_records; }
     
     int get_simulation_time() const { return current_sim_time_minutes.load(); }
     void set_simulation_time(int minutes) { current_sim_time_minutes = minutes; }
 
     void log_event(const std::string& message);
-    void set_diag_logging(bool enabled) { enable_diag_logs = enabled; }
+    void log_trace(TraceEvent type, int order_id, int agv_id = -1, int component = -1, int value = 0);
+    bool enable_event_trace(const std::string& filename);
+    void enable_timeline(const std::string& filename) { timeline_file = filename; }
+    void set_report_files(const std::string& kpi_report, const std::string& kpi_json, const std::string& order_results);
+    SimMetrics& metrics() { return sim_metrics; }
+
+    // Per-order results, reported by the assembly station as orders move through it
+    void record_order_staged(int order_id);
+    void record_order_kitted(int order_id);
+    void record_order_started(int order_id, int line_id, int start_minutes, int setup_minutes);
+    void record_agv_trip(int order_id);
+    void set_diag_logging(bool enabled) { set_log_level(enabled ? LogLevel::DIAG : LogLevel::INFO); }
+    void set_log_level(LogLevel level);
+    bool log_enabled(LogLevel level) const { return static_cast<int>(level) <= log_level.load(std::memory_order_relaxed); }
+
+    // CONWIP release control: at most wip_cap orders (and cards per product family) in the system
+    void set_conwip(int wip_cap) { conwip_cap = wip_cap; }
+    void set_kanban_cards(const std::string& product_family, int cards) { kanban_cards[product_family] = cards; }
 };
 
 #endif /* CONTROL_CENTER_H */
@@ -0,0 +1,139 @@
+/**
+ * @file DispatchRule.cpp
+ * @brief Dispatch rule implementations (FIFO, PRIORITY, SPT, EDD, ATC, weighted slack)
+ */
+
+/******************************Project Headers*****************************************/
+#include "DispatchRule.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cmath>
+#include <limits>
+#include <algorithm>
+/*************************************************************************************/
+
+namespace {
+
+const double NO_DUE_DATE = std::numeric_limits<double>::max() / 4;
+
+/**
+ * @brief Due date of an order, or a very late time when none was given
+ */
+double due_or_infinity(const Order& order) {
+    return order.due_date_minutes >= 0 ? order.due_date_minutes : NO_DUE_DATE;
+}
+
+// First in, first out: earliest release first
+class FifoRule : public DispatchRule {
+public:
+    double key(const Order& order, int, int) const override { return order.release_time_minutes; }
+    const char* name() const override { return "FIFO"; }
+};
+
+// Highest priority first
+class PriorityRule : public DispatchRule {
+public:
+    double key(const Order& order, int, int) const override { return -order.priority; }
+    const char* name() const override { return "PRIORITY"; }
+};
+
+// Shortest processing time first
+class SptRule : public DispatchRule {
+public:
+    double key(const Order&, int processing_minutes, int) const override { return processing_minutes; }
+    const char* name() const override { return "SPT"; }
+};
+
+// Earliest due date first
+class EddRule : public DispatchRule {
+public:
+    double key(const Order& order, int, int) const override { return due_or_infinity(order); }
+    const char* name() const override { return "EDD"; }
+};
+
+/**
+ * Apparent Tardiness Cost: index = (w/p) * exp(-max(d - p - t, 0) / (K * p_mean)).
+ * The largest index is most urgent, so the key is its negation.
+ */
+class AtcRule : public DispatchRule {
+private:
+    double k;
+    double mean_processing;
+
+public:
+    AtcRule(double k_factor, double mean_p) : k(k_factor), mean_processing(std::max(1.0, mean_p)) {}
+    double key(const Order& order, int processing_minutes, int now_minutes) const override {
+        double p = std::max(1, processing_minutes);
+        double slack = std::max(0.0, due_or_infinity(order) - p - now_minutes);
+        return -(weight(order) / p) * std::exp(-slack / (k * mean_processing));
+    }
+    const char* name() const override { return "ATC"; }
+    bool time_dependent() const override { return true; }
+};
+
+/**
+ * Weighted slack: slack = d - p - t, key = slack / w while on time and slack * w
+ * once late, so a heavier order always ranks as more urgent.
+ */
+class WeightedSlackRule : public DispatchRule {
+public:
+    double key(const Order& order, int processing_minutes, int now_minutes) const override {
+        if (order.due_date_minutes < 0) return NO_DUE_DATE;
+        double slack = due_or_infinity(order) - processing_minutes - now_minutes;
+        return slack >= 0 ? slack / weight(order) : slack * weight(order);
+    }
+    const char* name() const override { return "WEIGHTED_SLACK"; }
+    bool time_dependent() const override { return true; }
+};
+
+} // namespace
+
+/**
+ * @brief Create the dispatch rule for a scheduling policy
+ * @param policy The scheduling policy
+ * @param mean_processing_minutes Average processing time (used by ATC)
+ * @return Owning pointer to the rule
+ */
+std::unique_ptr<DispatchRule> make_dispatch_rule(SchedulingPolicy policy, double mean_processing_minutes) {
+    switch (policy) {
+        case SchedulingPolicy::PRIORITY:       return std::unique_ptr<DispatchRule>(new PriorityRule());
+        case SchedulingPolicy::SPT:            return std::unique_ptr<DispatchRule>(new SptRule());
+        case SchedulingPolicy::EDD:            return std::unique_ptr<DispatchRule>(new EddRule());
+        case SchedulingPolicy::ATC:            return std::unique_ptr<DispatchRule>(new AtcRule(2.0, mean_processing_minutes));
+        case SchedulingPolicy::WEIGHTED_SLACK: return std::unique_ptr<DispatchRule>(new WeightedSlackRule());
+        case SchedulingPolicy::FIFO:
+        default:                               return std::unique_ptr<DispatchRule>(new FifoRule());
+    }
+}
+
+/**
+ * @brief Name of a scheduling policy
+ * @param policy The scheduling policy
+ * @return Upper-case policy name
+ */
+const char* to_string(SchedulingPolicy policy) {
+    switch (policy) {
+        case SchedulingPolicy::PRIORITY:       return "PRIORITY";
+        case SchedulingPolicy::SPT:            return "SPT";
+        case SchedulingPolicy::EDD:            return "EDD";
+        case SchedulingPolicy::ATC:            return "ATC";
+        case SchedulingPolicy::WEIGHTED_SLACK: return "WEIGHTED_SLACK";
+        case SchedulingPolicy::FIFO:
+        default:                               return "FIFO";
+    }
+}
+
+
+/**
+ * @brief Parse a policy name as printed by to_string (case-sensitive)
+ * @return false if the name is unknown
+ */
+bool parse_scheduling_policy(const std::string& name, SchedulingPolicy& policy) {
+    const SchedulingPolicy all[] = {SchedulingPolicy::FIFO, SchedulingPolicy::PRIORITY, SchedulingPolicy::SPT,
+                                    SchedulingPolicy::EDD, SchedulingPolicy::ATC, SchedulingPolicy::WEIGHTED_SLACK};
+    for (SchedulingPolicy candidate : all) {
+        if (name == to_string(candidate)) { policy = candidate; return true; }
+    }
+    return false;
+}
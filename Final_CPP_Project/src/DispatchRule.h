@@ -0,0 +1,161 @@
+/**
+ * @file DispatchRule.h
+ * @brief Dispatch rules shared by order release and the assembly ready queue
+ */
+
+#ifndef DISPATCH_RULE_H
+#define DISPATCH_RULE_H
+
+/******************************Project Headers*****************************************/
+#include "Order.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+/*************************************************************************************/
+
+/**
+ * @enum SchedulingPolicy
+ * @brief Enumeration of scheduling policies
+ */
+enum class SchedulingPolicy {
+    FIFO,
+    PRIORITY,
+    SPT,
+    EDD,
+    ATC,            // Apparent Tardiness Cost
+    WEIGHTED_SLACK  // Slack over order weight (priority) while on time, times weight once late
+};
+
+/****************************DispatchRule Class Definition****************************/
+/**
+ * @class DispatchRule
+ * @brief Maps an order to a dispatch key; the lowest key is dispatched first.
+ *
+ * The key is evaluated when the order enters a queue, so every rule is
+ * served by the same binary heap with O(log n) push/pop. Rules whose key
+ * depends on the current time (ATC, weighted slack) are re-keyed by
+ * DispatchQueue::refresh() before a pop once the clock has moved.
+ */
+class DispatchRule {
+public:
+    virtual ~DispatchRule() = default;
+
+    /**
+     * @brief Compute the dispatch key of an order
+     * @param order The order to rank
+     * @param processing_minutes Estimated processing time of the order
+     * @param now_minutes Simulation time at which the order is enqueued
+     * @return Key, smaller means more urgent
+     */
+    virtual double key(const Order& order, int processing_minutes, int now_minutes) const = 0;
+    virtual const char* name() const = 0;
+
+    // true if key() depends on now_minutes (the queue must be re-keyed as time passes)
+    virtual bool time_dependent() const { return false; }
+
+    // Order weight used by weighted rules (priority, at least 1)
+    static double weight(const Order& order) { return order.priority > 0 ? order.priority : 1.0; }
+};
+
+std::unique_ptr<DispatchRule> make_dispatch_rule(SchedulingPolicy policy, double mean_processing_minutes = 30.0);
+const char* to_string(SchedulingPolicy policy);
+bool parse_scheduling_policy(const std::string& name, SchedulingPolicy& policy);
+/*************************************************************************************/
+
+/****************************DispatchQueue Definition*********************************/
+/**
+ * @struct DispatchEntry
+ * @brief Heap entry: key first, then release time, then insertion sequence
+ */
+template <typename T>
+struct DispatchEntry {
+    double key;
+    int release_time_minutes;
+    uint64_t sequence;
+    T item;
+};
+
+template <typename T>
+struct DispatchEntryCompare {
+    bool operator()(const DispatchEntry<T>& a, const DispatchEntry<T>& b) const {
+        if (a.key != b.key) return a.key > b.key;
+        if (a.release_time_minutes != b.release_time_minutes) return a.release_time_minutes > b.release_time_minutes;
+        return a.sequence > b.sequence;
+    }
+};
+
+/**
+ * @class DispatchQueue
+ * @brief Min-heap of items ordered by a DispatchRule
+ *
+ * The heap is a plain vector so checkpoints can save and restore it as is.
+ * Time-dependent rules are re-keyed by refresh() before each pop: exactly
+ * whenever the clock has moved while at most REKEY_BATCH orders wait, and
+ * every size / REKEY_BATCH pops for larger backlogs, which bounds the cost
+ * at about REKEY_BATCH key evaluations per pop.
+ */
+template <typename T>
+class DispatchQueue {
+private:
+    std::vector<DispatchEntry<T>> heap;
+    uint64_t next_sequence = 0;
+    int keyed_at = INT_MIN;             // Time of the last re-key (INT_MIN = never)
+    uint32_t stale_pops = 0;            // Pops since the last re-key
+
+public:
+    static constexpr size_t REKEY_BATCH = 64;
+
+    void push(const T& item, const Order& order, const DispatchRule& rule, int processing_minutes, int now_minutes) {
+        heap.push_back(DispatchEntry<T>{rule.key(order, processing_minutes, now_minutes),
+                                        order.release_time_minutes, next_sequence++, item});
+        std::push_heap(heap.begin(), heap.end(), DispatchEntryCompare<T>());
+    }
+    const T& top() const { return heap.front().item; }
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), DispatchEntryCompare<T>());
+        heap.pop_back();
+    }
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    void clear() { heap.clear(); next_sequence = 0; keyed_at = INT_MIN; stale_pops = 0; }
+
+    /**
+     * @brief Re-evaluate the keys of a time-dependent rule before a pop
+     * @param rule The rule the queue is ranked by
+     * @param now_minutes Current simulation time
+     * @param key_of Callable returning rule.key(...) of an item at now_minutes
+     */
+    template <typename KeyOf>
+    void refresh(const DispatchRule& rule, int now_minutes, KeyOf key_of) {
+        if (!rule.time_dependent()) return;
+        if (now_minutes != keyed_at && (size_t)stale_pops * REKEY_BATCH >= heap.size()) {
+            for (DispatchEntry<T>& entry : heap) entry.key = key_of(entry.item);
+            std::make_heap(heap.begin(), heap.end(), DispatchEntryCompare<T>());
+            keyed_at = now_minutes;
+            stale_pops = 0;
+        }
+        stale_pops++;
+    }
+
+    // Checkpoint support: entries in heap order, the next insertion sequence and the re-key state
+    const std::vector<DispatchEntry<T>>& entries() const { return heap; }
+    uint64_t sequence() const { return next_sequence; }
+    int keyed_time() const { return keyed_at; }
+    uint32_t pops_since_rekey() const { return stale_pops; }
+    void assign(std::vector<DispatchEntry<T>> entries, uint64_t sequence, int keyed_time = INT_MIN, uint32_t pops = 0) {
+        heap = std::move(entries);
+        std::make_heap(heap.begin(), heap.end(), DispatchEntryCompare<T>());
+        next_sequence = sequence;
+        keyed_at = keyed_time;
+        stale_pops = pops;
+    }
+};
+/*************************************************************************************/
+#endif /* DISPATCH_RULE_H */
@@ -0,0 +1,445 @@
+/**
+ * @file EventTrace.cpp
+ * @brief Binary event trace writer, formatter and decoder
+ */
+
+/******************************Project Headers*****************************************/
+#include "EventTrace.h"
+#include "BufferedWriter.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+/*************************************************************************************/
+
+namespace {
+
+const char TRACE_MAGIC[8] = {'F', 'A', 'S', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t TRACE_VERSION = 1;
+
+/**
+ * @struct TraceHeader
+ * @brief First bytes of a trace file; rewritten by close()
+ */
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+    uint64_t names_offset;      // Start of the names footer
+};
+
+std::string clock_string(int minutes) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d:%02d", minutes / 60, minutes % 60);
+    return text;
+}
+
+void put_u32(std::string& out, uint32_t value) { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+void put_name(std::string& out, const std::string& name) {
+    put_u32(out, (uint32_t)name.size());
+    out.append(name);
+}
+
+/**
+ * @brief Bounds-checked reader over the footer bytes
+ */
+struct FooterReader {
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool ok;
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        if (pos + sizeof(value) > size) { ok = false; return 0; }
+        std::memcpy(&value, data + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    }
+    std::string name() {
+        uint32_t length = u32();
+        if (!ok || pos + length > size) { ok = false; return std::string(); }
+        std::string text(data + pos, length);
+        pos += length;
+        return text;
+    }
+};
+
+}  // namespace
+
+/****************************TraceNames Methods**************************************/
+
+/**
+ * @brief Build the order_id lookup used by order()
+ */
+void TraceNames::index_orders() {
+    int max_id = -1;
+    for (const auto& order : orders) max_id = std::max(max_id, order.order_id);
+    order_index.assign(max_id + 1, -1);
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (orders[i].order_id >= 0) order_index[orders[i].order_id] = (int)i;
+    }
+}
+
+
+/**
+ * @brief Make room for orders added while events are being formatted
+ * add_order() within this room never reallocates, so other threads may keep
+ * looking up the orders they already know about.
+ */
+void TraceNames::reserve_orders(size_t order_count, int max_order_id) {
+    orders.reserve(order_count);
+    if (max_order_id >= (int)order_index.size()) order_index.resize(max_order_id + 1, -1);
+}
+
+
+/**
+ * @brief Add one order after index_orders() (within reserve_orders() room)
+ */
+void TraceNames::add_order(const TraceOrderName& name) {
+    orders.push_back(name);
+    if (name.order_id >= 0 && name.order_id < (int)order_index.size()) order_index[name.order_id] = (int)orders.size() - 1;
+}
+
+
+/**
+ * @brief Order attributes by ID
+ * @return The order, or nullptr if unknown
+ */
+const TraceOrderName* TraceNames::order(int order_id) const {
+    if (order_id < 0 || order_id >= (int)order_index.size() || order_index[order_id] < 0) return nullptr;
+    return &orders[order_index[order_id]];
+}
+
+
+/**
+ * @brief Component name by warehouse index ("?" if unknown)
+ */
+const std::string& TraceNames::component(int index) const {
+    static const std::string unknown = "?";
+    return (index >= 0 && index < (int)components.size()) ? components[index] : unknown;
+}
+
+
+/**
+ * @brief Log message of a typed event, exactly as the text log prints it
+ * @param record The event (not TEXT)
+ * @param names Names referenced by the record
+ * @return Message without the leading HH:MM log time
+ */
+std::string format_trace_event(const TraceRecord& record, const TraceNames& names) {
+    const TraceOrderName* order = names.order(record.order_id);
+    const std::string product = order ? order->product_id : std::string("?");
+    const std::string id = std::to_string(record.order_id);
+    const std::string agv = "AGV" + std::to_string(record.agv_id);
+
+    switch (static_cast<TraceEvent>(record.type)) {
+        case TraceEvent::ORDER_RELEASED:
+            return clock_string(order ? order->release_minutes : record.sim_minutes) + " Order released: " + product +
+                   " (Priority: " + std::to_string(order ? order->priority : 0) + ", ID: " + id + ")";
+        case TraceEvent::ORDER_COMPLETED:
+            return clock_string(record.value) + " Order completed: " + product + " (ID: " + id + ")";
+        case TraceEvent::ORDER_CANCELED:
+            return clock_string(record.sim_minutes) + " Order canceled: " + product + " (ID: " + id + ")";
+        case TraceEvent::ORDER_HELD:
+            return "[Diag] order " + id + " held behind starving parked order";
+        case TraceEvent::ORDER_PARKED:
+            return "[Diag] request_components failed, parked order " + product + " (ID " + id + ")";
+        case TraceEvent::PARKED_ORDER_STAGED:
+            return "[Diag] staged parked order " + id + " after " + std::to_string(record.value) + " attempt(s)";
+        case TraceEvent::STAGING_FAILED:
+            return "[Diag] request_components failed permanently for order ID " + id;
+        case TraceEvent::COMPONENT_ASSIGNED:
+            return "[Diag] assign_task " + names.component(record.component) + " to " + agv + " (order " + id + ")";
+        case TraceEvent::COMPONENT_DELIVERED:
+            return "[Diag] delivered " + names.component(record.component) + " x" + std::to_string(record.value) +
+                   " for order " + id;
+        case TraceEvent::KIT_COMPLETE:
+            return "[Diag] all components delivered for order " + id;
+        case TraceEvent::PRODUCT_ASSIGNED:
+            return "[Diag] assign finished product " + product + " to " + agv;
+        case TraceEvent::PRODUCT_RETURN_DEFERRED:
+            return "[Diag] could not dispatch finished product return for " + product + " immediately";
+        case TraceEvent::PRODUCT_DELIVERED:
+            return "[Diag] finished product delivered " + product;
+        case TraceEvent::COMPONENT_SHORT:
+            return "[Diag] order " + id + " short of " + names.component(record.component) + ": " +
+                   std::to_string(record.value) + " unit(s) missing";
+        default:
+            return "[Trace] unknown event type " + std::to_string(record.type);
+    }
+}
+/*************************************************************************************/
+
+/****************************EventTrace Methods***************************************/
+
+/**
+ * @brief Constructor for EventTrace
+ */
+EventTrace::EventTrace()
+    : fd(-1), next_record(0), segments(new std::atomic<char*>[MAX_SEGMENTS]), dropped(0), file_bytes(0) {
+    for (size_t i = 0; i < MAX_SEGMENTS; ++i) segments[i].store(nullptr, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Destructor for EventTrace (closes without a names footer if still open)
+ */
+EventTrace::~EventTrace() {
+    if (is_open()) close(TraceNames());
+}
+
+
+/**
+ * @brief Create the trace file and reserve its header
+ * @param filename Path of the trace file (truncated)
+ * @return true on success
+ */
+bool EventTrace::open(const std::string& filename) {
+#ifdef _WIN32
+    std::cerr << "Warning: Binary event trace is not supported on Windows" << std::endl;
+    (void)filename;
+    return false;
+#else
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+    file_bytes = DATA_OFFSET;
+    if (ftruncate(fd, (off_t)file_bytes) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    next_record = 0;
+    dropped = 0;
+    return true;
+#endif
+}
+
+
+/**
+ * @brief Address of a reserved record slot, mapping its segment on first use
+ * @param index Record number
+ * @return The slot, or nullptr if it cannot be mapped
+ */
+TraceRecord* EventTrace::slot(uint64_t index) {
+#ifdef _WIN32
+    (void)index;
+    return nullptr;
+#else
+    const size_t segment_bytes = SEGMENT_RECORDS * sizeof(TraceRecord);
+    uint64_t segment = index / SEGMENT_RECORDS;
+    if (segment >= MAX_SEGMENTS) return nullptr;
+    char* base = segments[segment].load(std::memory_order_acquire);
+    if (!base) {
+        std::lock_guard<std::mutex> lock(map_mutex);
+        base = segments[segment].load(std::memory_order_relaxed);
+        if (!base) {
+            uint64_t end = DATA_OFFSET + (segment + 1) * segment_bytes;
+            if (end > file_bytes) {         //Segments may be first touched out of order
+                if (ftruncate(fd, (off_t)end) != 0) return nullptr;
+                file_bytes = end;
+            }
+            void* mapped = mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                                (off_t)(DATA_OFFSET + segment * segment_bytes));
+            if (mapped == MAP_FAILED) return nullptr;
+            base = static_cast<char*>(mapped);
+            segments[segment].store(base, std::memory_order_release);
+        }
+    }
+    return reinterpret_cast<TraceRecord*>(base) + index % SEGMENT_RECORDS;
+#endif
+}
+
+
+/**
+ * @brief Append one typed record
+ * @param record The event
+ */
+void EventTrace::append(const TraceRecord& record) {
+    if (fd < 0) return;
+    TraceRecord* target = slot(next_record.fetch_add(1, std::memory_order_relaxed));
+    if (target) {
+        *target = record;
+    } else {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ * @brief Append a free-text event (one TEXT record followed by its bytes)
+ * @param sim_minutes Log time of the event
+ * @param text The message
+ */
+void EventTrace::append_text(int sim_minutes, const std::string& text) {
+    if (fd < 0) return;
+    uint64_t chunks = (text.size() + sizeof(TraceRecord) - 1) / sizeof(TraceRecord);
+    uint64_t first = next_record.fetch_add(1 + chunks, std::memory_order_relaxed);  //Contiguous in the file
+
+    TraceRecord header{sim_minutes, static_cast<uint16_t>(TraceEvent::TEXT), 0, -1, -1, -1, (int32_t)text.size()};
+    TraceRecord* target = slot(first);
+    if (!target) {
+        dropped.fetch_add(1 + chunks, std::memory_order_relaxed);
+        return;
+    }
+    *target = header;
+    for (uint64_t i = 0; i < chunks; ++i) {
+        TraceRecord* raw = slot(first + 1 + i);
+        if (!raw) { dropped.fetch_add(1, std::memory_order_relaxed); continue; }
+        size_t offset = i * sizeof(TraceRecord);
+        size_t length = std::min(sizeof(TraceRecord), text.size() - offset);
+        std::memset(raw, 0, sizeof(TraceRecord));
+        std::memcpy(raw, text.data() + offset, length);
+    }
+}
+
+
+/**
+ * @brief Unmap, trim the file to the records written, then add the names footer and header
+ * @param names Component and order names referenced by the records
+ * @return true if the trace was completed
+ */
+bool EventTrace::close(const TraceNames& names) {
+#ifdef _WIN32
+    (void)names;
+    return false;
+#else
+    if (fd < 0) return false;
+    const size_t segment_bytes = SEGMENT_RECORDS * sizeof(TraceRecord);
+    for (size_t i = 0; i < MAX_SEGMENTS; ++i) {
+        char* base = segments[i].exchange(nullptr);
+        if (base) munmap(base, segment_bytes);
+    }
+
+    uint64_t count = next_record.load();
+    uint64_t names_offset = DATA_OFFSET + count * sizeof(TraceRecord);
+    std::string footer;
+    put_u32(footer, (uint32_t)names.components.size());
+    for (const auto& name : names.components) put_name(footer, name);
+    put_u32(footer, (uint32_t)names.orders.size());
+    for (const auto& order : names.orders) {
+        put_u32(footer, (uint32_t)order.order_id);
+        put_u32(footer, (uint32_t)order.priority);
+        put_u32(footer, (uint32_t)order.release_minutes);
+        put_name(footer, order.product_id);
+    }
+
+    TraceHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.record_count = count;
+    header.names_offset = names_offset;
+
+    bool ok = ftruncate(fd, (off_t)names_offset) == 0 &&
+              pwrite(fd, footer.data(), footer.size(), (off_t)names_offset) == (ssize_t)footer.size() &&
+              pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+    ::close(fd);
+    fd = -1;
+    if (dropped.load() > 0) {
+        std::cerr << "Warning: " << dropped.load() << " trace record(s) could not be written" << std::endl;
+    }
+    return ok;
+#endif
+}
+
+
+/**
+ * @brief Regenerate the text log from a binary trace
+ * @param trace_file Trace written by EventTrace
+ * @param log_file Text log to write (same format as sim_log.txt)
+ * @return Number of events decoded, or -1 on error
+ */
+long EventTrace::decode(const std::string& trace_file, const std::string& log_file) {
+    std::FILE* in = std::fopen(trace_file.c_str(), "rb");
+    if (!in) {
+        std::cerr << "Error: Cannot open file " << trace_file << std::endl;
+        return -1;
+    }
+    std::vector<char> data;
+    char chunk[1 << 16];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), in)) > 0) data.insert(data.end(), chunk, chunk + got);
+    std::fclose(in);
+
+    TraceHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "Error: " << trace_file << " is not an event trace" << std::endl;
+        return -1;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 || header.version != TRACE_VERSION ||
+        header.record_size != sizeof(TraceRecord)) {
+        std::cerr << "Error: " << trace_file << " is not a version " << TRACE_VERSION << " event trace" << std::endl;
+        return -1;
+    }
+    if (header.names_offset != DATA_OFFSET + header.record_count * sizeof(TraceRecord) ||
+        header.names_offset > data.size()) {
+        std::cerr << "Error: " << trace_file << " is truncated or was not closed" << std::endl;
+        return -1;
+    }
+
+    TraceNames names;
+    FooterReader footer{data.data() + header.names_offset, data.size() - header.names_offset, 0, true};
+    uint32_t component_count = footer.u32();
+    for (uint32_t i = 0; i < component_count && footer.ok; ++i) names.components.push_back(footer.name());
+    uint32_t order_count = footer.u32();
+    for (uint32_t i = 0; i < order_count && footer.ok; ++i) {
+        TraceOrderName order;
+        order.order_id = (int32_t)footer.u32();
+        order.priority = (int32_t)footer.u32();
+        order.release_minutes = (int32_t)footer.u32();
+        order.product_id = footer.name();
+        names.orders.push_back(order);
+    }
+    if (!footer.ok) {
+        std::cerr << "Error: " << trace_file << " has a corrupt names table" << std::endl;
+        return -1;
+    }
+    names.index_orders();
+
+    BufferedWriter out(log_file);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << log_file << std::endl;
+        return -1;
+    }
+    out.put("=== Simulation Log ===\n\n");
+
+    long events = 0;
+    const char* records = data.data() + DATA_OFFSET;
+    for (uint64_t i = 0; i < header.record_count; ++i) {
+        TraceRecord record;
+        std::memcpy(&record, records + i * sizeof(TraceRecord), sizeof(record));
+        if (record.type == static_cast<uint16_t>(TraceEvent::NONE)) continue;     //Dropped slot
+        out.put(clock_string(record.sim_minutes)).put(' ');
+        if (record.type == static_cast<uint16_t>(TraceEvent::TEXT)) {
+            uint64_t length = (uint64_t)std::max<int32_t>(record.value, 0);
+            uint64_t chunks = (length + sizeof(TraceRecord) - 1) / sizeof(TraceRecord);
+            if (i + chunks >= header.record_count) {    //Text runs past the last record
+                length = 0;
+                chunks = header.record_count - 1 - i;
+            }
+            out.write(records + (i + 1) * sizeof(TraceRecord), (size_t)length);
+            i += chunks;
+        } else {
+            out.put(format_trace_event(record, names));
+        }
+        out.put('\n');
+        ++events;
+    }
+    return out.close() ? events : -1;
+}
+/*************************************************************************************/
@@ -0,0 +1,131 @@
+/**
+ * @file EventTrace.h
+ * @brief Compact binary event trace (fixed-size records) and its decoder
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+/*****************************Standard Libraries***************************************/
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @enum TraceEvent
+ * @brief Event type stored in a trace record (values are part of the file format)
+ */
+enum class TraceEvent : uint16_t {
+    NONE = 0,                   // Never written; unused space reads as NONE
+    TEXT = 1,                   // Free text; value = length, followed by the bytes in raw records
+    ORDER_RELEASED = 2,
+    ORDER_COMPLETED = 3,        // value = completion time (line virtual minutes)
+    ORDER_CANCELED = 4,
+    ORDER_HELD = 5,             // Held behind a starving parked order
+    ORDER_PARKED = 6,           // Components short; parked for retry
+    PARKED_ORDER_STAGED = 7,    // value = attempts
+    STAGING_FAILED = 8,         // Retries exhausted
+    COMPONENT_ASSIGNED = 9,
+    COMPONENT_DELIVERED = 10,   // value = quantity
+    KIT_COMPLETE = 11,
+    PRODUCT_ASSIGNED = 12,      // Finished product return
+    PRODUCT_RETURN_DEFERRED = 13,
+    PRODUCT_DELIVERED = 14,
+    COMPONENT_SHORT = 15        // Reservation failed; value = units missing
+};
+
+/**
+ * @struct TraceRecord
+ * @brief One 24-byte trace record (native byte order); unused ids are -1
+ */
+struct TraceRecord {
+    int32_t sim_minutes;
+    uint16_t type;              // TraceEvent
+    uint16_t reserved;
+    int32_t order_id;
+    int32_t agv_id;
+    int32_t component;          // Warehouse component index
+    int32_t value;
+};
+static_assert(sizeof(TraceRecord) == 24, "TraceRecord is part of the file format");
+
+/**
+ * @struct TraceOrderName
+ * @brief Order attributes the decoder needs to print an event
+ */
+struct TraceOrderName {
+    int order_id = -1;
+    int priority = 0;
+    int release_minutes = 0;
+    std::string product_id;
+};
+
+/**
+ * @struct TraceNames
+ * @brief Names referenced by record ids; stored once in the trace footer
+ */
+struct TraceNames {
+    std::vector<std::string> components;    // By warehouse component index
+    std::vector<TraceOrderName> orders;
+
+    void index_orders();
+    void reserve_orders(size_t order_count, int max_order_id);
+    void add_order(const TraceOrderName& name);
+    const TraceOrderName* order(int order_id) const;
+    const std::string& component(int index) const;
+
+private:
+    std::vector<int> order_index;           // order_id -> position in orders
+};
+
+std::string format_trace_event(const TraceRecord& record, const TraceNames& names);
+
+/****************************EventTrace Class Definition******************************/
+/**
+ * @class EventTrace
+ * @brief Appends records to a memory-mapped file from any thread without locks
+ *
+ * A writer reserves record slots with one fetch_add and copies the record
+ * into the mapping; the file grows in fixed segments that are mapped on
+ * first use (the only locked path). Text events take one record plus as
+ * many raw records as their bytes need. close() writes the names footer
+ * and the record count into the header. Not available on Windows:
+ * open() returns false.
+ *
+ * Layout: 4 KB header, records, names footer.
+ */
+class EventTrace {
+private:
+    static const size_t DATA_OFFSET = 4096;
+    static const size_t SEGMENT_RECORDS = 1 << 17;  // 3 MB, a whole number of pages
+    static const size_t MAX_SEGMENTS = 4096;
+
+    int fd;
+    std::atomic<uint64_t> next_record;
+    std::unique_ptr<std::atomic<char*>[]> segments;
+    std::atomic<uint64_t> dropped;                  // Records past the last segment or unmappable
+    std::mutex map_mutex;                           // Mapping a new segment only
+    uint64_t file_bytes;                            // Current file size (under map_mutex)
+
+    TraceRecord* slot(uint64_t index);
+
+public:
+    EventTrace();
+    ~EventTrace();
+    EventTrace(const EventTrace&) = delete;
+    EventTrace& operator=(const EventTrace&) = delete;
+
+    bool open(const std::string& filename);
+    bool is_open() const { return fd >= 0; }
+    void append(const TraceRecord& record);
+    void append_text(int sim_minutes, const std::string& text);
+    bool close(const TraceNames& names);
+
+    static long decode(const std::string& trace_file, const std::string& log_file);
+};
+/*************************************************************************************/
+#endif /* EVENT_TRACE_H */
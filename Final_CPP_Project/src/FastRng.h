@@ -0,0 +1,66 @@
+/**
+ * @file FastRng.h
+ * @brief Small, fast, seedable random number generator for replications
+ */
+
+#ifndef FAST_RNG_H
+#define FAST_RNG_H
+
+/*****************************Standard Libraries***************************************/
+#include <cmath>
+#include <cstdint>
+/*************************************************************************************/
+
+/****************************FastRng Class Definition*********************************/
+/**
+ * @class FastRng
+ * @brief xoshiro256** seeded through SplitMix64
+ *
+ * A (seed, stream) pair always gives the same sequence, so replication r
+ * draws the same numbers whichever thread runs it. 32 bytes of state,
+ * no locks: one generator per replication.
+ */
+class FastRng {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit FastRng(uint64_t seed, uint64_t stream = 0) {
+        uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+        for (auto& word : s) word = splitmix64(state);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Standard normal (Box-Muller; the second value is discarded)
+    double normal() {
+        double u1 = 1.0 - uniform();    //(0, 1]: log() stays finite
+        double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    // Raw state for checkpoints: a restored generator continues the same sequence
+    void save(uint64_t state[4]) const { for (int i = 0; i < 4; ++i) state[i] = s[i]; }
+    void restore(const uint64_t state[4]) { for (int i = 0; i < 4; ++i) s[i] = state[i]; }
+};
+/*************************************************************************************/
+#endif /* FAST_RNG_H */
@@ -0,0 +1,526 @@
+/**
+ * @file FastSimulator.cpp
+ * @brief Fast sequence evaluator implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "FastSimulator.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+/*************************************************************************************/
+
+/****************************Time Sampling*******************************************/
+/**
+ * @brief Draw a duration around a nominal value
+ * @param nominal Nominal duration in minutes
+ * @param distribution Shape of the distribution
+ * @param spread Relative half-width, or coefficient of variation for LOGNORMAL
+ * @param rng Generator of the replication (nullptr = nominal value)
+ * @return Duration in whole minutes; rounded stochastically so the mean is kept
+ */
+static int sample_minutes(int nominal, TimeDistribution distribution, double spread, FastRng* rng) {
+    if (!rng || distribution == TimeDistribution::CONSTANT || nominal <= 0 || spread <= 0.0) return nominal;
+    double value = nominal;
+    switch (distribution) {
+        case TimeDistribution::UNIFORM:
+            value = nominal * (1.0 + spread * (2.0 * rng->uniform() - 1.0));
+            break;
+        case TimeDistribution::TRIANGULAR:
+            value = nominal * (1.0 + spread * (rng->uniform() + rng->uniform() - 1.0));
+            break;
+        case TimeDistribution::LOGNORMAL: {
+            double sigma2 = std::log(1.0 + spread * spread);
+            value = nominal * std::exp(std::sqrt(sigma2) * rng->normal() - 0.5 * sigma2);
+            break;
+        }
+        case TimeDistribution::CONSTANT:
+            break;
+    }
+    return std::max(0, (int)std::floor(value + rng->uniform()));
+}
+/*************************************************************************************/
+
+/****************************FastSimulator Methods***********************************/
+
+/**
+ * @brief Constructor: compile orders, products and inventory into index form
+ * @param order_list Orders to simulate
+ * @param products Product definitions (BOM and base time)
+ * @param inventory Initial component inventory
+ * @param config Cell parameters
+ */
+FastSimulator::FastSimulator(const std::vector<Order>& order_list,
+                             const std::map<std::string, Product>& products,
+                             const std::map<std::string, int>& inventory,
+                             const FastSimConfig& config)
+    : orders(order_list), cfg(config) {
+    cfg.num_agvs = std::max(1, cfg.num_agvs);
+    cfg.num_lines = std::max(1, cfg.num_lines);
+
+    std::map<std::string, int> component_index;
+    auto index_of = [&component_index](const std::string& id) {
+        auto it = component_index.find(id);
+        if (it != component_index.end()) return it->second;
+        int index = (int)component_index.size();
+        component_index[id] = index;
+        return index;
+    };
+
+    std::map<std::string, int> product_index;
+    for (const auto& kv : products) {
+        CompiledProduct cp;
+        cp.base_time_minutes = kv.second.base_assembly_time_minutes;
+        for (const auto& comp : kv.second.bom) {
+            cp.bom.emplace_back(index_of(comp.first), comp.second);
+        }
+        product_index[kv.first] = (int)compiled_products.size();
+        compiled_products.push_back(cp);
+    }
+    for (const auto& kv : inventory) { index_of(kv.first); }
+
+    initial_inventory.assign(component_index.size(), 0);
+    for (const auto& kv : inventory) { initial_inventory[component_index[kv.first]] = kv.second; }
+
+    for (const auto& order : orders) {
+        auto it = product_index.find(order.product_id);
+        compiled_orders.push_back(CompiledOrder{order.release_time_minutes, order.due_date_minutes,
+                                                it != product_index.end() ? it->second : -1});
+    }
+
+    std::vector<std::string> product_names;
+    for (const auto& kv : products) product_names.push_back(kv.first);
+    compile_release_control(product_names);
+}
+
+
+/**
+ * @brief Constructor: take the index form straight from a compiled scenario
+ * The image already numbers products and components the way the map
+ * constructor does, so both constructors build the same model.
+ * @param image Opened scenario image (may be closed afterwards)
+ * @param config Cell parameters
+ */
+FastSimulator::FastSimulator(const ScenarioImage& image, const FastSimConfig& config)
+    : cfg(config) {
+    cfg.num_agvs = std::max(1, cfg.num_agvs);
+    cfg.num_lines = std::max(1, cfg.num_lines);
+
+    compiled_products.resize(image.product_count());
+    for (size_t i = 0; i < image.product_count(); ++i) {
+        const ScenarioProduct& record = image.products()[i];
+        compiled_products[i].base_time_minutes = record.base_time_minutes;
+        compiled_products[i].bom.reserve(record.bom_count);
+        for (uint32_t b = record.bom_first; b < record.bom_first + record.bom_count; ++b) {
+            compiled_products[i].bom.emplace_back((int)image.bom()[b].component, image.bom()[b].quantity);
+        }
+    }
+    initial_inventory.resize(image.component_count());
+    for (size_t i = 0; i < image.component_count(); ++i) {
+        initial_inventory[i] = image.components()[i].initial_stock;
+    }
+
+    orders.resize(image.order_count());
+    compiled_orders.resize(image.order_count());
+    for (size_t i = 0; i < image.order_count(); ++i) {
+        const ScenarioOrder& record = image.orders()[i];
+        orders[i].order_id = record.order_id;
+        orders[i].release_time_minutes = record.release_time_minutes;
+        orders[i].release_hour = record.release_time_minutes / 60;
+        orders[i].release_minute = record.release_time_minutes % 60;
+        orders[i].product_id = std::string(image.name(record.product_id));
+        orders[i].priority = record.priority;
+        orders[i].due_date_minutes = record.due_date_minutes;
+        compiled_orders[i] = CompiledOrder{record.release_time_minutes, record.due_date_minutes, record.product_index};
+    }
+
+    std::vector<std::string> product_names;
+    for (size_t i = 0; i < image.product_count(); ++i) {
+        product_names.emplace_back(image.name(image.products()[i].product_id));
+    }
+    compile_release_control(product_names);
+}
+
+
+/**
+ * @brief Map the kanban cards of the config onto product indices
+ * @param product_names Product ID per product index
+ */
+void FastSimulator::compile_release_control(const std::vector<std::string>& product_names) {
+    cfg.conwip_cap = std::max(0, cfg.conwip_cap);
+    family_cards.assign(product_names.size(), 0);
+    for (size_t i = 0; i < product_names.size(); ++i) {
+        auto cards = cfg.kanban_cards.find(product_names[i]);
+        if (cards != cfg.kanban_cards.end()) family_cards[i] = std::max(1, cards->second);
+    }
+}
+
+
+/**
+ * @brief Check whether orders of a product occupy a CONWIP slot or kanban card
+ */
+bool FastSimulator::tracks_wip(int product_index) const {
+    return cfg.conwip_cap > 0 || (product_index >= 0 && family_cards[product_index] > 0);
+}
+
+
+/**
+ * @brief Advance the staging clock until the CONWIP cap and the family's cards admit an order
+ * Orders leave the cell at their completion time.
+ * @param product_index Product of the order (-1 if unknown)
+ * @param state Run state, updated in place
+ */
+void FastSimulator::admit(int product_index, FastSimState& state) const {
+    if (!tracks_wip(product_index)) return;
+    int cards = product_index >= 0 ? family_cards[product_index] : 0;
+    std::vector<std::pair<int, int>>& in_system = state.in_system;
+    std::greater<std::pair<int, int>> by_exit;
+    while (true) {
+        while (!in_system.empty() && in_system.front().first <= state.clock) {
+            std::pop_heap(in_system.begin(), in_system.end(), by_exit);
+            in_system.pop_back();
+        }
+        bool cell_full = cfg.conwip_cap > 0 && (int)in_system.size() >= cfg.conwip_cap;
+        int family_count = 0, family_exit = INT_MAX;
+        if (cards > 0) {
+            for (const auto& entry : in_system) {
+                if (entry.second != product_index) continue;
+                family_count++;
+                family_exit = std::min(family_exit, entry.first);
+            }
+        }
+        bool family_full = cards > 0 && family_count >= cards;
+        if (!cell_full && !family_full) return;
+        state.clock = cell_full ? in_system.front().first : family_exit;
+    }
+}
+
+
+/**
+ * @brief Plan that stages orders by release time and uses the first free line
+ * @return The default plan
+ */
+SequencePlan FastSimulator::default_plan() const {
+    SequencePlan plan;
+    plan.sequence.resize(orders.size());
+    std::iota(plan.sequence.begin(), plan.sequence.end(), 0);
+    std::stable_sort(plan.sequence.begin(), plan.sequence.end(), [this](int a, int b) {
+        return compiled_orders[a].release_time_minutes < compiled_orders[b].release_time_minutes;
+    });
+    plan.lines.assign(orders.size(), -1);
+    return plan;
+}
+
+
+/**
+ * @brief Fresh state for one run (initial stock, idle AGVs and lines, every order pending)
+ */
+FastSimState FastSimulator::start_run() const {
+    FastSimState state;
+    state.inventory = initial_inventory;
+    state.agv_free.assign(cfg.num_agvs, 0);
+    state.line_free.assign(cfg.num_lines, 0);
+    state.line_product.assign(cfg.num_lines, -1);
+    state.order_states.assign(orders.size(), OrderState::PENDING);
+    return state;
+}
+
+
+/**
+ * @brief Stage one order: reserve its BOM, deliver the kit and assemble it
+ * @param position Position of the order in the order list
+ * @param line Assembly line (-1 or out of range = first free line)
+ * @param state Run state, updated in place
+ * @param rng Generator for stochastic times (nullptr = nominal times)
+ */
+void FastSimulator::stage_order(int position, int line, FastSimState& state, FastRng* rng) const {
+    auto travel = [this, rng](int nominal) {
+        return sample_minutes(nominal, cfg.travel_distribution, cfg.travel_spread, rng);
+    };
+    auto processing = [this, rng](int nominal) {
+        return sample_minutes(nominal, cfg.processing_distribution, cfg.processing_spread, rng);
+    };
+    FastSimResult& result = state.result;
+    const CompiledOrder& order = compiled_orders[position];
+    if (state.first_release < 0 || order.release_time_minutes < state.first_release) state.first_release = order.release_time_minutes;
+    state.clock = std::max(state.clock, order.release_time_minutes);
+    state.order_states[position] = OrderState::CANCELED;
+
+    if (order.product_index < 0) { result.canceled++; return; }
+    const CompiledProduct& product = compiled_products[order.product_index];
+    admit(order.product_index, state);
+
+    for (const auto& req : product.bom) {
+        if (state.inventory[req.first] < req.second) { result.canceled++; return; }
+    }
+    for (const auto& req : product.bom) { state.inventory[req.first] -= req.second; }
+
+    std::vector<int>& agv_free = state.agv_free;   //Min-heap of AGV free times
+    int kit_ready = state.clock;
+    for (const auto& req : product.bom) {
+        for (int q = 0; q < req.second; ++q) {   //One AGV trip per unit
+            int trip_to_station = travel(cfg.travel_time_warehouse_minutes) + travel(cfg.picking_time_minutes)
+                                + travel(cfg.travel_time_station_minutes) + travel(cfg.dropping_time_minutes);
+            int component_trip = trip_to_station + travel(cfg.return_time_minutes);
+            std::pop_heap(agv_free.begin(), agv_free.end(), std::greater<int>());
+            int start = std::max(state.clock, agv_free.back());
+            state.clock = start;                          //Staging blocks until an AGV accepts the unit
+            kit_ready = std::max(kit_ready, start + trip_to_station);
+            agv_free.back() = start + component_trip;
+            std::push_heap(agv_free.begin(), agv_free.end(), std::greater<int>());
+            state.agv_busy += component_trip;
+        }
+    }
+
+    if (line < 0 || line >= cfg.num_lines) {
+        line = (int)(std::min_element(state.line_free.begin(), state.line_free.end()) - state.line_free.begin());
+    }
+    int setup = (state.line_product[line] == order.product_index) ? 0 : processing(cfg.setup_time_minutes);
+    int operation = processing(product.base_time_minutes) + setup;
+    int completion = std::max(kit_ready, state.line_free[line]) + operation;
+    state.line_free[line] = completion;
+    state.line_product[line] = order.product_index;
+    state.station_busy += operation;
+    state.agv_busy += travel(cfg.travel_time_warehouse_minutes) + travel(cfg.picking_time_minutes)    //Finished-product return:
+                    + travel(cfg.travel_time_station_minutes) + travel(cfg.dropping_time_minutes)     //same legs in the
+                    + travel(cfg.return_time_minutes);                                                //opposite direction
+
+    if (tracks_wip(order.product_index)) {
+        state.in_system.emplace_back(completion, order.product_index);
+        std::push_heap(state.in_system.begin(), state.in_system.end(), std::greater<std::pair<int, int>>());
+    }
+
+    result.completed++;
+    state.order_states[position] = OrderState::COMPLETED;
+    state.total_lead += completion - order.release_time_minutes;
+    state.last_completion = std::max(state.last_completion, completion);
+    if (order.due_date_minutes >= 0 && completion > order.due_date_minutes) {
+        int tardiness = completion - order.due_date_minutes;
+        result.total_tardiness += tardiness;
+        result.max_tardiness = std::max(result.max_tardiness, tardiness);
+        result.late_orders++;
+    }
+}
+
+
+/**
+ * @brief Turn the totals of a run into KPIs
+ * @param state Final run state
+ * @return KPIs of the run
+ */
+FastSimResult FastSimulator::finish_run(const FastSimState& state) const {
+    FastSimResult result = state.result;
+    int span = state.last_completion - std::max(0, state.first_release);
+    if (span <= 0) span = 1;
+    result.makespan_minutes = (result.completed > 0) ? span : 0;
+    result.avg_lead_time = (result.completed > 0) ? (double)state.total_lead / result.completed : 0.0;
+    result.station_utilization = (double)state.station_busy / ((double)cfg.num_lines * span);
+    result.throughput = result.completed * 60.0 / span;
+    result.agv_utilization = (double)state.agv_busy / ((double)cfg.num_agvs * span);
+    return result;
+}
+
+
+/**
+ * @brief Simulate a plan and compute its KPIs
+ * @param plan Staging sequence and line assignment
+ * @param rng Generator for stochastic times (nullptr = deterministic run)
+ * @return KPIs of the run
+ */
+FastSimResult FastSimulator::evaluate(const SequencePlan& plan, FastRng* rng) const {
+    FastSimState state = start_run();
+    for (int position : plan.sequence) {
+        int line = (position < (int)plan.lines.size()) ? plan.lines[position] : -1;
+        stage_order(position, line, state, rng);
+    }
+    return finish_run(state);
+}
+
+
+/**
+ * @brief Simulate dispatching by a rule, as the threaded simulation does
+ * Orders are ranked when they are released (staging clock reached their
+ * release time); the most urgent released order is staged next.
+ * @param rule Dispatch rule (key evaluated at release, re-evaluated before each pop if time-dependent)
+ * @param rng Generator for stochastic times (nullptr = deterministic run)
+ * @param staged Optional output: order positions in staging order
+ * @return KPIs of the run
+ */
+FastSimResult FastSimulator::evaluate(const DispatchRule& rule, FastRng* rng, std::vector<int>* staged) const {
+    FastSimState state = start_run();
+    if (rng) {
+        state.stochastic = true;
+        state.rng = *rng;
+    }
+    advance(state, rule, INT_MAX, staged);
+    if (rng) *rng = state.rng;
+    return finish_run(state);
+}
+
+
+/**
+ * @brief Continue a rule run until the staging clock reaches a time
+ * The run stops before staging the next order once the clock is at or past
+ * until_minutes, with every order released by then in the queue, so
+ * advancing in several steps stages exactly what one call would. A state
+ * whose queue was keyed by another rule is re-keyed at the current clock
+ * (forking a run under a different policy).
+ * @param state Run state from start_run(), a copy or a checkpoint; updated in place
+ * @param rule Dispatch rule (key evaluated at release, re-evaluated before each pop if time-dependent)
+ * @param until_minutes Stop time (INT_MAX = run to the end)
+ * @param staged Optional output: order positions in staging order
+ * @return true once every order has been staged
+ */
+bool FastSimulator::advance(FastSimState& state, const DispatchRule& rule, int until_minutes, std::vector<int>* staged) const {
+    if (state.rule != rule.name()) {
+        if (!state.released.empty()) {
+            std::vector<DispatchEntry<int>> entries = state.released.entries();
+            std::sort(entries.begin(), entries.end(), [](const DispatchEntry<int>& a, const DispatchEntry<int>& b) {
+                return a.sequence < b.sequence;
+            });
+            state.released.clear();
+            for (const DispatchEntry<int>& entry : entries) {
+                state.released.push(entry.item, orders[entry.item], rule, processing_time(entry.item), state.clock);
+            }
+        }
+        state.rule = rule.name();
+    }
+
+    std::vector<int> by_release = default_plan().sequence;
+    FastRng* rng = state.stochastic ? &state.rng : nullptr;
+    while (state.next_release < by_release.size() || !state.released.empty()) {
+        if (state.released.empty()) {
+            state.clock = std::max(state.clock, compiled_orders[by_release[state.next_release]].release_time_minutes);
+        }
+        for (; state.next_release < by_release.size() &&
+               compiled_orders[by_release[state.next_release]].release_time_minutes <= state.clock; ++state.next_release) {
+            int position = by_release[state.next_release];
+            state.order_states[position] = OrderState::RELEASED;
+            state.released.push(position, orders[position], rule, processing_time(position), state.clock);
+        }
+        if (state.clock >= until_minutes) return false;
+        state.released.refresh(rule, state.clock, [&](int queued) {
+            return rule.key(orders[queued], processing_time(queued), state.clock);
+        });
+        int position = state.released.top();
+        state.released.pop();
+        if (staged) staged->push_back(position);
+        stage_order(position, -1, state, rng);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Check that a state (e.g. a loaded checkpoint) belongs to this scenario and cell
+ * @param error Set to the first mismatch found
+ * @return true if the state can be advanced
+ */
+bool FastSimulator::check_state(const FastSimState& state, std::string& error) const {
+    if (state.order_states.size() != orders.size()) {
+        error = "it has " + std::to_string(state.order_states.size()) + " orders, the scenario has " + std::to_string(orders.size());
+    } else if (state.inventory.size() != initial_inventory.size()) {
+        error = "it has " + std::to_string(state.inventory.size()) + " components, the scenario has " + std::to_string(initial_inventory.size());
+    } else if ((int)state.agv_free.size() != cfg.num_agvs || (int)state.line_free.size() != cfg.num_lines ||
+               state.line_product.size() != state.line_free.size()) {
+        error = "it was taken with " + std::to_string(state.agv_free.size()) + " AGVs and " + std::to_string(state.line_free.size())
+              + " lines, the cell has " + std::to_string(cfg.num_agvs) + " and " + std::to_string(cfg.num_lines);
+    } else if (state.next_release > orders.size()) {
+        error = "its release count is out of range";
+    } else {
+        for (const DispatchEntry<int>& entry : state.released.entries()) {
+            if (entry.item < 0 || entry.item >= (int)orders.size()) {
+                error = "its release queue names an unknown order";
+                return false;
+            }
+        }
+        for (int product : state.line_product) {
+            if (product < -1 || product >= (int)compiled_products.size()) {
+                error = "a line names an unknown product";
+                return false;
+            }
+        }
+        for (const auto& entry : state.in_system) {
+            if (entry.second < 0 || entry.second >= (int)compiled_products.size()) {
+                error = "its WIP list names an unknown product";
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * @brief Nominal assembly time of an order (30 minutes if its product is unknown)
+ */
+int FastSimulator::processing_time(int position) const {
+    int product = compiled_orders[position].product_index;
+    return product >= 0 ? compiled_products[product].base_time_minutes : 30;
+}
+
+
+/**
+ * @brief Mean nominal assembly time over all orders (ATC scaling)
+ */
+double FastSimulator::mean_processing_time() const {
+    if (orders.empty()) return 30.0;
+    double total = 0.0;
+    for (size_t i = 0; i < orders.size(); ++i) total += processing_time((int)i);
+    return total / orders.size();
+}
+
+
+const char* to_string(TimeDistribution distribution) {
+    switch (distribution) {
+        case TimeDistribution::UNIFORM: return "UNIFORM";
+        case TimeDistribution::TRIANGULAR: return "TRIANGULAR";
+        case TimeDistribution::LOGNORMAL: return "LOGNORMAL";
+        case TimeDistribution::CONSTANT: break;
+    }
+    return "CONSTANT";
+}
+
+/**
+ * @brief Parse a distribution name (constant, uniform, triangular, lognormal)
+ * @return false if the name is unknown
+ */
+bool parse_time_distribution(const std::string& name, TimeDistribution& distribution) {
+    if (name == "constant") distribution = TimeDistribution::CONSTANT;
+    else if (name == "uniform") distribution = TimeDistribution::UNIFORM;
+    else if (name == "triangular") distribution = TimeDistribution::TRIANGULAR;
+    else if (name == "lognormal") distribution = TimeDistribution::LOGNORMAL;
+    else return false;
+    return true;
+}
+
+
+/**
+ * @brief Layout section of a scenario image for a cell configuration
+ */
+ScenarioLayout to_scenario_layout(const FastSimConfig& config) {
+    return ScenarioLayout{config.num_agvs, config.num_lines, config.setup_time_minutes,
+                          config.travel_time_warehouse_minutes, config.travel_time_station_minutes,
+                          config.picking_time_minutes, config.dropping_time_minutes, config.return_time_minutes};
+}
+
+
+/**
+ * @brief Copy a scenario's layout into a cell configuration (distributions are kept)
+ */
+void apply_scenario_layout(const ScenarioLayout& layout, FastSimConfig& config) {
+    config.num_agvs = layout.num_agvs;
+    config.num_lines = layout.num_lines;
+    config.setup_time_minutes = layout.setup_time_minutes;
+    config.travel_time_warehouse_minutes = layout.travel_time_warehouse_minutes;
+    config.travel_time_station_minutes = layout.travel_time_station_minutes;
+    config.picking_time_minutes = layout.picking_time_minutes;
+    config.dropping_time_minutes = layout.dropping_time_minutes;
+    config.return_time_minutes = layout.return_time_minutes;
+}
+/*************************************************************************************/
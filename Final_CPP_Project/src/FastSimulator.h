@@ -0,0 +1,188 @@
+/**
+ * @file FastSimulator.h
+ * @brief Single-threaded analytic model of the assembly cell used to evaluate sequences
+ */
+
+#ifndef FAST_SIMULATOR_H
+#define FAST_SIMULATOR_H
+
+/******************************Project Headers*****************************************/
+#include "Order.h"
+#include "Product.h"
+#include "FastRng.h"
+#include "DispatchRule.h"
+#include "ScenarioImage.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <climits>
+#include <map>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @enum TimeDistribution
+ * @brief Distribution of a processing or travel time around its nominal value
+ */
+enum class TimeDistribution {
+    CONSTANT,       // Nominal value (deterministic model)
+    UNIFORM,        // nominal x [1 - spread, 1 + spread]
+    TRIANGULAR,     // Symmetric, same support as UNIFORM
+    LOGNORMAL       // Mean = nominal, coefficient of variation = spread
+};
+
+/**
+ * @struct FastSimConfig
+ * @brief Cell parameters; defaults mirror AGV and AssemblyStation
+ */
+struct FastSimConfig {
+    int num_agvs = 10;
+    int num_lines = 1;
+    int setup_time_minutes = 5;
+    int travel_time_warehouse_minutes = 2;
+    int travel_time_station_minutes = 3;
+    int picking_time_minutes = 1;
+    int dropping_time_minutes = 1;
+    int return_time_minutes = 2;
+
+    // Stochastic times, used only when evaluate() is given a generator
+    TimeDistribution processing_distribution = TimeDistribution::CONSTANT;  // Assembly and setup
+    double processing_spread = 0.0;
+    TimeDistribution travel_distribution = TimeDistribution::CONSTANT;      // Every AGV leg
+    double travel_spread = 0.0;
+
+    // CONWIP / kanban release control, as in the threaded model (0 and no cards = off)
+    int conwip_cap = 0;                         // Max customer orders in the cell
+    std::map<std::string, int> kanban_cards;    // Product family -> cards (at least 1)
+};
+
+/**
+ * @struct FastSimResult
+ * @brief KPIs of one fast simulation run
+ */
+struct FastSimResult {
+    double avg_lead_time = 0.0;
+    int makespan_minutes = 0;           // Last completion minus first release
+    long long total_tardiness = 0;
+    int max_tardiness = 0;
+    int late_orders = 0;
+    int completed = 0;
+    int canceled = 0;
+    double station_utilization = 0.0;
+    double throughput = 0.0;            // Orders per hour
+    double agv_utilization = 0.0;
+};
+
+/**
+ * @struct SequencePlan
+ * @brief Staging sequence (positions into the order list) and line per order
+ */
+struct SequencePlan {
+    std::vector<int> sequence;   // Order positions in staging order
+    std::vector<int> lines;      // lines[position] = assembly line, -1 = first free line
+};
+
+/**
+ * @struct FastSimState
+ * @brief Complete state of a run between two staging decisions
+ *
+ * Holds everything needed to continue a run: stock, the time each AGV
+ * finishes its current mission, each line's queued work, the state of every
+ * order, the released-but-not-staged queue, the staging clock and the
+ * generator. Copying it forks the run; SimCheckpoint saves it to a file.
+ */
+struct FastSimState {
+    int clock = 0;                              // Staging clock in minutes
+    int first_release = -1, last_completion = 0;
+    long long agv_busy = 0, station_busy = 0, total_lead = 0;
+    FastSimResult result;                       // Counters so far (completed, canceled, tardiness)
+    std::vector<int> inventory;                 // Stock per component index
+    std::vector<int> agv_free;                  // Min-heap of AGV free times (in-flight missions)
+    std::vector<int> line_free;                 // End of the work queued on each line
+    std::vector<int> line_product;              // Last product per line (setup)
+    std::vector<OrderState> order_states;       // Per order position
+    std::vector<std::pair<int, int>> in_system; // Min-heap of (exit time, product) of orders under release control
+    DispatchQueue<int> released;                // Released orders waiting to be staged (rule runs)
+    size_t next_release = 0;                    // Orders released so far, in release order
+    std::string rule;                           // Rule that keyed the released queue
+    bool stochastic = false;                    // Draw times from rng
+    FastRng rng{0};
+};
+
+/****************************FastSimulator Class Definition***************************/
+/**
+ * @class FastSimulator
+ * @brief Evaluates a SequencePlan without threads or sleeps
+ *
+ * Orders are staged strictly in plan order: each one waits for its release
+ * time, reserves its BOM (an order that cannot be reserved is canceled) and
+ * sends one AGV trip per unit. The kit is ready when the last unit arrives;
+ * the order then runs on its line after any earlier order on that line.
+ * Finished-product returns count towards AGV busy time but do not block
+ * later component trips. With CONWIP or kanban cards an order is staged only
+ * once the cell (and its family) has room; it waits for its own card rather
+ * than letting a later order of another family skip ahead. evaluate() is
+ * const and safe to call concurrently. The rule overload stages the most
+ * urgent released order instead, like the threaded release loop. With a
+ * generator, every assembly, setup and AGV leg is drawn from the configured
+ * distribution (rounded stochastically to whole minutes). Rule runs can also
+ * be advanced in steps with advance() and stopped at any clock time.
+ */
+class FastSimulator {
+private:
+    struct CompiledOrder {
+        int release_time_minutes;
+        int due_date_minutes;
+        int product_index;          // -1 if the product has no BOM entry
+    };
+    struct CompiledProduct {
+        int base_time_minutes;
+        std::vector<std::pair<int, int>> bom;   // component index, quantity
+    };
+
+    std::vector<Order> orders;
+    std::vector<CompiledOrder> compiled_orders;
+    std::vector<CompiledProduct> compiled_products;
+    std::vector<int> initial_inventory;         // Per component index
+    std::vector<int> family_cards;              // Kanban cards per product index (0 = no limit)
+    FastSimConfig cfg;
+
+    void compile_release_control(const std::vector<std::string>& product_names);
+    bool tracks_wip(int product_index) const;
+    void admit(int product_index, FastSimState& state) const;
+    void stage_order(int position, int line, FastSimState& state, FastRng* rng) const;
+
+public:
+    FastSimulator(const std::vector<Order>& order_list,
+                  const std::map<std::string, Product>& products,
+                  const std::map<std::string, int>& inventory,
+                  const FastSimConfig& config = FastSimConfig());
+    FastSimulator(const ScenarioImage& image, const FastSimConfig& config);
+
+    FastSimResult evaluate(const SequencePlan& plan, FastRng* rng = nullptr) const;
+    FastSimResult evaluate(const DispatchRule& rule, FastRng* rng = nullptr, std::vector<int>* staged = nullptr) const;
+
+    // Stepwise rule runs: split, checkpoint, resume or fork a long horizon
+    FastSimState start_run() const;
+    bool advance(FastSimState& state, const DispatchRule& rule, int until_minutes = INT_MAX,
+                 std::vector<int>* staged = nullptr) const;
+    FastSimResult finish_run(const FastSimState& state) const;
+    bool check_state(const FastSimState& state, std::string& error) const;
+
+    SequencePlan default_plan() const;
+    int processing_time(int position) const;
+    double mean_processing_time() const;
+
+    size_t order_count() const { return orders.size(); }
+    size_t component_count() const { return initial_inventory.size(); }
+    const Order& order_at(size_t position) const { return orders[position]; }
+    const FastSimConfig& config() const { return cfg; }
+};
+
+const char* to_string(TimeDistribution distribution);
+bool parse_time_distribution(const std::string& name, TimeDistribution& distribution);
+ScenarioLayout to_scenario_layout(const FastSimConfig& config);
+void apply_scenario_layout(const ScenarioLayout& layout, FastSimConfig& config);
+/*************************************************************************************/
+#endif /* FAST_SIMULATOR_H */
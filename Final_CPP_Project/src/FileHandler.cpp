@@ -5,10 +5,15 @@
 
 /******************************Project Headers*****************************************/
 #include "FileHandler.h"
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "TextScan.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <iomanip>
 #include <sys/stat.h>
 #include <sys/types.h>
 #ifdef _WIN32
@@ -21,144 +26,199 @@
 
 /****************************FileHandler Methods*************************************/
 
+/**
+ * @brief Report a malformed input line as "file:line: message"
+ */
+static void warn_line(const std::string& filename, int line_number, const std::string& message) {
+    std::cerr << "Warning: " << filename << ":" << line_number << ": " << message << std::endl;
+}
+
+
 /**
  * @brief Read orders from a file
+ * The file is memory-mapped and scanned in place; malformed lines are reported and skipped.
  * @param filename Path to the orders file
  * @param orders Vector to populate with read orders
  * @return true if successful, false otherwise
  */
 bool FileHandler::read_orders_file(const std::string& filename, std::vector<Order>& orders) {
-    std::ifstream file(filename);
+    MappedFile file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         return false;
     }
     
-    std::string line;
+    std::string_view text = file.view();
+    size_t line_count = std::count(text.begin(), text.end(), '\n') + 1;
+    orders.reserve(orders.size() + line_count);
+    LineReader lines(text);
+    std::string_view line;
+    std::string error;
+    std::vector<bool> used_ids(line_count + 1, false);   // IDs stay dense: id=N is at most the line count
     int order_id = 1;  // Start order IDs from 1
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        std::istringstream iss(line);
-        int hour, minute, priority = 0;
-        std::string product_id;
+    while (lines.next(line)) {
+        if (is_comment_or_blank(line)) continue;
         
-        if (iss >> hour >> minute >> product_id) {
-            iss >> priority;  // Optional priority
-            
-            Order order;
+        Order order;
+        if (!parse_order_line(line, order, error)) {
+            warn_line(filename, lines.line_number(), error);
+            continue;
+        }
+        if (order.order_id == 0) {      // No id=N: next unused ID
+            while (order_id < (int)used_ids.size() && used_ids[order_id]) ++order_id;
             order.order_id = order_id++;
-            order.release_hour = hour;
-            order.release_minute = minute;
-            order.release_time_minutes = time_to_minutes(hour, minute);
-            order.product_id = product_id;
-            order.priority = priority;
-            
-            orders.push_back(order);
         }
+        if (order.order_id >= (int)used_ids.size() || used_ids[order.order_id]) {
+            warn_line(filename, lines.line_number(), "order ID " + std::to_string(order.order_id) +
+                      (order.order_id >= (int)used_ids.size() ? " above the line count" : " already used") + ", order ignored");
+            continue;
+        }
+        used_ids[order.order_id] = true;
+        orders.push_back(std::move(order));
+    }
+    return true;
+}
+
+
+/**
+ * @brief Parse one order line: HH MM product_id [priority] [due HH:MM] [id=N]
+ * Shared by the orders file reader and the streaming reader. order_id is N
+ * (at least 1) when the line carries id=N and 0 otherwise; the caller assigns
+ * IDs to the others.
+ * @param line The line (not blank, not a comment)
+ * @param order Filled on success
+ * @param error Set to the reason on failure
+ * @return true if the line is a valid order
+ */
+bool FileHandler::parse_order_line(std::string_view line, Order& order, std::string& error) {
+    std::string_view tokens[6];
+    size_t count = split_tokens(line, tokens, 6);
+    int hour = 0, minute = 0, priority = 0, due_date = -1, order_id = 0;
+    if (count > 3 && count <= 6 && tokens[count - 1].substr(0, 3) == "id=") {    // Optional trailing order ID
+        if (!parse_number(tokens[count - 1].substr(3), order_id) || order_id < 1) {
+            error = "invalid order ID '" + std::string(tokens[count - 1]) + "', order ignored";
+            return false;
+        }
+        --count;
+    }
+    if (count < 3 || count > 5 || !parse_number(tokens[0], hour) || !parse_number(tokens[1], minute)) {
+        error = "expected 'HH MM product_id [priority] [due HH:MM] [id=N]', order ignored";
+        return false;
+    }
+    if (count >= 4 && !parse_number(tokens[3], priority)) {  // Optional priority
+        error = "invalid priority '" + std::string(tokens[3]) + "', order ignored";
+        return false;
+    }
+    if (count == 5 && !parse_clock(tokens[4], due_date)) {  // Optional due date (HH:MM)
+        error = "invalid due date '" + std::string(tokens[4]) + "', order ignored";
+        return false;
     }
     
-    file.close();
+    order.release_hour = hour;
+    order.release_minute = minute;
+    order.release_time_minutes = time_to_minutes(hour, minute);
+    order.product_id.assign(tokens[2].data(), tokens[2].size());
+    order.priority = priority;
+    order.due_date_minutes = due_date;
+    order.order_id = order_id;
     return true;
 }
 
 
 /**
  * @brief Read Bill of Materials (BOM) from a file
+ * The file is memory-mapped and scanned in place; malformed lines are reported and skipped.
  * @param filename Path to the BOM file
  * @param products Map to populate with read products
  * @return true if successful, false otherwise
  */
 bool FileHandler::read_bom_file(const std::string& filename, std::map<std::string, Product>& products) {
-    std::ifstream file(filename);
+    MappedFile file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         return false;
     }
     
-    std::string line;
-    std::string current_product_id;
-    
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        std::istringstream iss(line);
-        std::vector<std::string> tokens;
-        std::string tok;
-        while (iss >> tok) tokens.push_back(tok);
-        if (tokens.empty()) continue;
+    Product* current = nullptr;     // Product of the last product line
+    auto product = [&products, &current](std::string_view id) -> Product& {
+        if (current && current->product_id == id) return *current;  //Consecutive lines of one product
+        Product& p = products[std::string(id)];
+        if (p.product_id.empty()) p.product_id = std::string(id);
+        return p;
+    };
+
+    LineReader lines(file.view());
+    std::string_view line;
+    std::string_view tokens[3];
+    while (lines.next(line)) {
+        if (is_comment_or_blank(line)) continue;
+        size_t count = split_tokens(line, tokens, 3);
         
         // Formats supported:
         // 1) product_id base_time
-        // 2) product_id component_id quantity
+        // 2) product_id component_id quantity   (component_id may be another product: sub-assembly)
         // 3) component_id quantity (uses last current_product_id)
-        if (tokens.size() == 2 && tokens[0][0] == 'P') {
+        int number = 0;
+        if (count == 2 && tokens[0][0] == 'P') {
             // product_id base_time
-            std::istringstream bt(tokens[1]);
-            int base_time = 0;
-            if (bt >> base_time && bt.eof()) {
-                current_product_id = tokens[0];
-                Product& p = products[current_product_id];
-                p.product_id = current_product_id;
-                p.base_assembly_time_minutes = base_time;
+            if (!parse_number(tokens[1], number)) {
+                warn_line(filename, lines.line_number(), "invalid base time '" + std::string(tokens[1]) + "'");
+                continue;
             }
-        } else if (tokens.size() == 3 && tokens[0][0] == 'P' && tokens[1][0] == 'C') {
+            current = &product(tokens[0]);
+            current->base_assembly_time_minutes = number;
+        } else if (count == 3 && tokens[0][0] == 'P' && (tokens[1][0] == 'C' || tokens[1][0] == 'P')) {
             // product_id component_id quantity
-            std::istringstream qss(tokens[2]);
-            int qty = 0;
-            if (qss >> qty && qss.eof()) {
-                const std::string& pid = tokens[0];
-                const std::string& cid = tokens[1];
-                Product& p = products[pid];
-                if (p.product_id.empty()) p.product_id = pid;
-                p.bom[cid] = qty;
-                current_product_id = pid;
+            if (!parse_number(tokens[2], number)) {
+                warn_line(filename, lines.line_number(), "invalid quantity '" + std::string(tokens[2]) + "'");
+                continue;
             }
-        } else if (tokens.size() == 2 && tokens[0][0] == 'C' && !current_product_id.empty()) {
+            current = &product(tokens[0]);
+            current->bom[std::string(tokens[1])] = number;
+        } else if (count == 2 && tokens[0][0] == 'C' && current) {
             // component_id quantity for current product
-            std::istringstream qss(tokens[1]);
-            int qty = 0;
-            if (qss >> qty && qss.eof()) {
-                const std::string& cid = tokens[0];
-                Product& p = products[current_product_id];
-                p.bom[cid] = qty;
+            if (!parse_number(tokens[1], number)) {
+                warn_line(filename, lines.line_number(), "invalid quantity '" + std::string(tokens[1]) + "'");
+                continue;
             }
+            current->bom[std::string(tokens[0])] = number;
+        } else {
+            warn_line(filename, lines.line_number(), "unrecognized BOM line, expected 'product_id base_time', "
+                                                     "'product_id component_id quantity' or 'component_id quantity'");
         }
     }
-    
-    file.close();
     return true;
 }
 
 
 /**
  * @brief Read warehouse inventory from a file
+ * The file is memory-mapped and scanned in place; malformed lines are reported and skipped.
  * @param filename Path to the warehouse file
  * @param inventory Map to populate with component quantities
  * @return true if successful, false otherwise
  */
 bool FileHandler::read_warehouse_file(const std::string& filename,
                                        std::map<std::string, int>& inventory) {
-    std::ifstream file(filename);
+    MappedFile file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         return false;
     }
     
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
+    LineReader lines(file.view());
+    std::string_view line;
+    std::string_view tokens[2];
+    while (lines.next(line)) {
+        if (is_comment_or_blank(line)) continue;
         
-        std::istringstream iss(line);
-        std::string component_id;
-        int quantity;
-        
-        if (iss >> component_id >> quantity) {
-            inventory[component_id] = quantity;
+        int quantity = 0;
+        if (split_tokens(line, tokens, 2) != 2 || !parse_number(tokens[1], quantity)) {
+            warn_line(filename, lines.line_number(), "expected 'component_id quantity'");
+            continue;
         }
+        inventory[std::string(tokens[0])] = quantity;
     }
-    
-    file.close();
     return true;
 }
 
@@ -167,17 +227,10 @@ bool FileHandler::read_warehouse_file(const std::string& filename,
 /**
  * @brief Write KPI report to file
  * @param filename Path to the output KPI report file
- * @param avg_lead_time Average lead time in minutes
- * @param station_utilization Assembly station utilization (0.0 - 1.0)
- * @param throughput Throughput in orders per hour
- * @param agv_utilization AGV utilization (0.0 - 1.0)
+ * @param kpis KPI values of the run
  * @return true if successful, false otherwise
  */
-bool FileHandler::write_kpi_report(const std::string& filename,
-                                    double avg_lead_time,
-                                    double station_utilization,
-                                    double throughput,
-                                    double agv_utilization) {
+bool FileHandler::write_kpi_report(const std::string& filename, const KpiReport& kpis) {
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot create file " << filename << std::endl;
@@ -188,10 +241,65 @@ bool FileHandler::write_kpi_report(const std::string& filename,
     file << "  Key Performance Indicators Report    \n";
     file << "========================================\n\n";
     
-    file << "Average Lead Time: " << avg_lead_time << " minutes\n";
-    file << "Assembly Station Utilization: " << (station_utilization * 100) << "%\n";
-    file << "Throughput: " << throughput << " orders/hour\n";
-    file << "Average AGV Utilization: " << (agv_utilization * 100) << "%\n";
+    file << "Average Lead Time: " << kpis.avg_lead_time << " minutes\n";
+    file << "Assembly Station Utilization: " << (kpis.station_utilization * 100) << "%\n";
+    file << "Throughput: " << kpis.throughput << " orders/hour\n";
+    file << "Average AGV Utilization: " << (kpis.agv_utilization * 100) << "%\n";
+
+    file << "\n--- Percentiles (minutes) ---\n";
+    file << std::left << std::setw(18) << "Metric" << std::right << std::setw(8) << "Count"
+         << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "Max" << "\n";
+    const std::pair<const char*, const PercentileSummary*> rows[] = {
+        {"Lead Time", &kpis.lead_time},
+        {"Queue Wait", &kpis.queue_wait},
+        {"Kit Preparation", &kpis.kit_preparation},
+        {"AGV Response", &kpis.agv_response},
+    };
+    for (const auto& row : rows) {
+        file << std::left << std::setw(18) << row.first << std::right << std::setw(8) << row.second->count
+             << std::setw(10) << row.second->p50 << std::setw(10) << row.second->p90
+             << std::setw(10) << row.second->p99 << std::setw(10) << row.second->max << "\n";
+    }
+
+    file << "\n--- Release Control ---\n";
+    file << "CONWIP Cap: " << (kpis.conwip_cap > 0 ? std::to_string(kpis.conwip_cap) : std::string("off")) << "\n";
+    file << "Average WIP: " << kpis.avg_wip << " orders\n";
+    file << "Max WIP: " << kpis.max_wip << " orders\n";
+    file << "Throughput per WIP: " << (kpis.avg_wip > 0 ? kpis.throughput / kpis.avg_wip : 0.0) << " orders/hour\n";
+
+    if (!kpis.queues.empty()) {
+        //Little's law: avg length should match arrivals x time in queue when the queue starts and ends empty
+        file << "\n--- Queue Lengths (time-weighted, AGV clock) ---\n";
+        file << std::left << std::setw(20) << "Queue" << std::right << std::setw(10) << "Avg" << std::setw(8) << "Max"
+             << std::setw(12) << "Arr/hour" << std::setw(12) << "Time(min)" << std::setw(12) << "Little L" << "\n";
+        for (const auto& queue : kpis.queues) {
+            file << std::left << std::setw(20) << queue.name << std::right << std::setw(10) << queue.avg_length
+                 << std::setw(8) << queue.max_length << std::setw(12) << queue.arrivals_per_hour;
+            if (queue.little_length >= 0) {
+                file << std::setw(12) << queue.mean_time_minutes << std::setw(12) << queue.little_length;
+            } else {
+                file << std::setw(12) << "-" << std::setw(12) << "-";
+            }
+            file << "\n";
+        }
+    }
+
+    if (kpis.orders_with_due_date > 0) {
+        file << "\n--- Due Date Performance (" << kpis.orders_with_due_date << " orders with due date) ---\n";
+        file << "Mean Tardiness: " << kpis.mean_tardiness << " minutes\n";
+        file << "Max Tardiness: " << kpis.max_tardiness << " minutes\n";
+        file << "Late Orders: " << kpis.late_orders << " (" << kpis.percent_late << "%)\n";
+        file << "Lateness Distribution (completion - due):\n";
+        const auto& bounds = LatenessHistogram::upper_bounds;
+        for (int bin = 0; bin < LatenessHistogram::BIN_COUNT; ++bin) {
+            std::ostringstream range;
+            if (bin == 0) range << "<= " << bounds[0];
+            else if (bin == LatenessHistogram::BIN_COUNT - 1) range << "> " << bounds[bin - 1];
+            else range << "(" << bounds[bin - 1] << ", " << bounds[bin] << "]";
+            file << "  " << std::left << std::setw(12) << range.str() << std::right
+                 << kpis.lateness.counts[bin] << "\n";
+        }
+    }
     
     file.close();
     return true;
@@ -199,6 +307,476 @@ bool FileHandler::write_kpi_report(const std::string& filename,
 
 
 
+/**
+ * @brief Write a string as a JSON string literal
+ */
+static void put_json_string(BufferedWriter& out, const std::string& text) {
+    out.put('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') out.put('\\').put(c);
+        else if ((unsigned char)c < 0x20) out.put(' ');
+        else out.put(c);
+    }
+    out.put('"');
+}
+
+
+/**
+ * @brief Write a percentile summary as a JSON object
+ */
+static void put_json_percentiles(BufferedWriter& out, const char* name, const PercentileSummary& summary) {
+    out.put("    \"").put(name).put("\": {\"count\": ").put(summary.count)
+       .put(", \"p50\": ").put(summary.p50).put(", \"p90\": ").put(summary.p90)
+       .put(", \"p99\": ").put(summary.p99).put(", \"max\": ").put(summary.max).put('}');
+}
+
+
+/**
+ * @brief Write the KPI report as a single JSON object (times in minutes)
+ * @param filename Path to the output JSON file
+ * @param kpis KPI values of the run
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_kpi_json(const std::string& filename, const KpiReport& kpis) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("{\n");
+    // Two clocks: lines advance virtual time, material flow runs on the AGV clock (AGV_MS_PER_MINUTE)
+    out.put("  \"clocks\": {\"line\": [\"avg_lead_time\", \"lead_time\", \"start_line_clock\", \"completion_line_clock\"], ")
+       .put("\"agv\": [\"queue_wait\", \"kit_preparation\", \"agv_response\", \"queues\", \"staged_agv_clock\", \"kitted_agv_clock\"]},\n");
+    out.put("  \"avg_lead_time\": ").put(kpis.avg_lead_time).put(",\n");
+    out.put("  \"station_utilization\": ").put(kpis.station_utilization).put(",\n");
+    out.put("  \"throughput_per_hour\": ").put(kpis.throughput).put(",\n");
+    out.put("  \"agv_utilization\": ").put(kpis.agv_utilization).put(",\n");
+
+    out.put("  \"percentiles\": {\n");
+    put_json_percentiles(out, "lead_time", kpis.lead_time); out.put(",\n");
+    put_json_percentiles(out, "queue_wait", kpis.queue_wait); out.put(",\n");
+    put_json_percentiles(out, "kit_preparation", kpis.kit_preparation); out.put(",\n");
+    put_json_percentiles(out, "agv_response", kpis.agv_response); out.put("\n  },\n");
+
+    out.put("  \"release_control\": {\"conwip_cap\": ").put(kpis.conwip_cap)
+       .put(", \"avg_wip\": ").put(kpis.avg_wip).put(", \"max_wip\": ").put(kpis.max_wip).put("},\n");
+
+    out.put("  \"queues\": [");
+    for (size_t i = 0; i < kpis.queues.size(); ++i) {
+        const QueueStats& queue = kpis.queues[i];
+        out.put(i ? ",\n    {\"name\": " : "\n    {\"name\": ");
+        put_json_string(out, queue.name);
+        out.put(", \"avg_length\": ").put(queue.avg_length).put(", \"max_length\": ").put(queue.max_length)
+           .put(", \"arrivals_per_hour\": ").put(queue.arrivals_per_hour);
+        if (queue.little_length >= 0) {
+            out.put(", \"mean_time\": ").put(queue.mean_time_minutes).put(", \"little_length\": ").put(queue.little_length);
+        }
+        out.put('}');
+    }
+    out.put(kpis.queues.empty() ? "],\n" : "\n  ],\n");
+
+    out.put("  \"due_dates\": {\"orders_with_due_date\": ").put(kpis.orders_with_due_date)
+       .put(", \"late_orders\": ").put(kpis.late_orders)
+       .put(", \"mean_tardiness\": ").put(kpis.mean_tardiness)
+       .put(", \"max_tardiness\": ").put(kpis.max_tardiness)
+       .put(", \"percent_late\": ").put(kpis.percent_late)
+       .put(", \"lateness_upper_bounds\": [");
+    for (int bin = 0; bin < LatenessHistogram::BIN_COUNT - 1; ++bin) {
+        if (bin) out.put(", ");
+        out.put(LatenessHistogram::upper_bounds[bin]);
+    }
+    out.put("], \"lateness_counts\": [");
+    for (int bin = 0; bin < LatenessHistogram::BIN_COUNT; ++bin) {
+        if (bin) out.put(", ");
+        out.put(kpis.lateness.counts[bin]);
+    }
+    out.put("]}\n}\n");
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write one CSV row per order
+ * Milestone columns name their clock: the AGV clock and the line clock are not
+ * synchronized, so a start can precede the kit on the other clock.
+ * @param filename Path to the output CSV file
+ * @param records Per-order results (-1 = did not happen)
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_order_csv(const std::string& filename, const std::vector<OrderRecord>& records) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("order_id,product_id,parent_order_id,status,release,due_date,staged_agv_clock,kitted_agv_clock,start_line_clock,completion_line_clock,line,setup_minutes,agv_trips\n");
+    for (const OrderRecord& record : records) {
+        out.put(record.order_id).put(',').put(record.product_id).put(',').put(record.parent_order_id).put(',')
+           .put(record.status).put(',').put(record.release).put(',').put(record.due_date).put(',')
+           .put(record.staged).put(',').put(record.kitted).put(',').put(record.start).put(',')
+           .put(record.completion).put(',').put(record.line).put(',').put(record.setup_minutes).put(',')
+           .put(record.agv_trips).put('\n');
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write an optimized sequence and its KPIs to file
+ * @param filename Path to the output file
+ * @param simulator Evaluator that owns the order list
+ * @param plan Sequence and line assignment to write
+ * @param kpis KPIs of the plan
+ * @param header Free-text description (method, objective, ...)
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_sequence_report(const std::string& filename,
+                                        const FastSimulator& simulator,
+                                        const SequencePlan& plan,
+                                        const FastSimResult& kpis,
+                                        const std::string& header) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    file << "========================================\n";
+    file << "  Optimized Release Sequence            \n";
+    file << "========================================\n";
+    file << header << "\n\n";
+
+    file << "# rank order_id HH MM product_id priority line\n";
+    int rank = 1;
+    for (int position : plan.sequence) {
+        const Order& order = simulator.order_at(position);
+        int line = (position < (int)plan.lines.size()) ? plan.lines[position] : -1;
+        file << rank++ << " " << order.order_id << " "
+             << order.release_hour << " " << order.release_minute << " "
+             << order.product_id << " " << order.priority << " "
+             << (line < 0 ? std::string("any") : std::to_string(line)) << "\n";
+    }
+
+    file << "\nAverage Lead Time: " << kpis.avg_lead_time << " minutes\n";
+    file << "Makespan: " << kpis.makespan_minutes << " minutes\n";
+    file << "Total Tardiness: " << kpis.total_tardiness << " minutes\n";
+    file << "Late Orders: " << kpis.late_orders << "\n";
+    file << "Completed / Canceled: " << kpis.completed << " / " << kpis.canceled << "\n";
+    file << "Assembly Station Utilization: " << (kpis.station_utilization * 100) << "%\n";
+    file << "Throughput: " << kpis.throughput << " orders/hour\n";
+    file << "Average AGV Utilization: " << (kpis.agv_utilization * 100) << "%\n";
+
+    file.close();
+    return true;
+}
+
+
+/**
+ * @brief Write KPI means and confidence intervals of a replication run
+ * @param filename Path to the output file
+ * @param result Per-replication KPIs and their estimates
+ * @param header Free-text description (replications, distributions, ...)
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_replication_report(const std::string& filename,
+                                           const ReplicationResult& result,
+                                           const std::string& header) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    file << "========================================\n";
+    file << "  Monte Carlo Replications              \n";
+    file << "========================================\n";
+    file << header << "\n\n";
+
+    file << std::left << std::setw(26) << "KPI" << std::right << std::setw(12) << "Mean"
+         << std::setw(12) << "+/-" << std::setw(12) << "StdDev" << std::setw(12) << "Min" << std::setw(12) << "Max" << "\n";
+    for (const KpiEstimate& e : result.estimates) {
+        file << std::left << std::setw(26) << e.name << std::right << std::fixed << std::setprecision(2)
+             << std::setw(12) << e.mean << std::setw(12) << e.half_width << std::setw(12) << e.stddev
+             << std::setw(12) << e.min << std::setw(12) << e.max << "\n";
+    }
+
+    file << "\n# replication avg_lead_time makespan total_tardiness late_orders completed canceled\n";
+    for (size_t r = 0; r < result.runs.size(); ++r) {
+        const FastSimResult& run = result.runs[r];
+        file << r << " " << run.avg_lead_time << " " << run.makespan_minutes << " " << run.total_tardiness << " "
+             << run.late_orders << " " << run.completed << " " << run.canceled << "\n";
+    }
+
+    file.close();
+    return true;
+}
+
+
+/**
+ * @brief Write the results of a parameter sweep, one CSV row per configuration
+ * @param filename Path to the output CSV file
+ * @param inputs Input sets (names)
+ * @param points Configurations and their KPIs
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_sweep_results(const std::string& filename,
+                                      const std::vector<SweepInput>& inputs,
+                                      const std::vector<SweepPoint>& points) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("input,agvs,lines,policy,avg_lead_time,makespan,throughput,station_utilization,agv_utilization,"
+            "total_tardiness,max_tardiness,late_orders,completed,canceled\n");
+    for (const SweepPoint& point : points) {
+        const FastSimResult& k = point.kpis;
+        out.put(inputs[point.input_index].name).put(',').put(point.num_agvs).put(',').put(point.num_lines).put(',')
+           .put(to_string(point.policy)).put(',').put(k.avg_lead_time).put(',').put(k.makespan_minutes).put(',')
+           .put(k.throughput).put(',').put(k.station_utilization).put(',').put(k.agv_utilization).put(',')
+           .put((long long)k.total_tardiness).put(',').put(k.max_tardiness).put(',').put(k.late_orders).put(',')
+           .put(k.completed).put(',').put(k.canceled).put('\n');
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Start one Chrome trace-event object on a (process, thread) track
+ */
+static void put_trace_event(BufferedWriter& out, bool& first, int pid, int tid) {
+    out.put(first ? "\n  " : ",\n  ");
+    first = false;
+    out.put("{\"pid\": ").put(pid).put(", \"tid\": ").put(tid).put(", ");
+}
+
+/**
+ * @brief Write a complete ("X") span with its order, load and line virtual times
+ */
+static void put_trace_span(BufferedWriter& out, bool& first, int pid, int tid, const char* category,
+                           const TimelineSpan& span) {
+    put_trace_event(out, first, pid, tid);
+    out.put("\"ph\": \"X\", \"cat\": \"").put(category).put("\", \"name\": \"").put(span.name)
+       .put("\", \"ts\": ").put((long long)span.start_us).put(", \"dur\": ").put((long long)(span.end_us - span.start_us))
+       .put(", \"args\": {\"order\": ").put(span.order_id).put(", \"load\": ");
+    put_json_string(out, span.load);
+    if (span.virtual_start >= 0) {
+        out.put(", \"line_start_min\": ").put(span.virtual_start).put(", \"line_end_min\": ").put(span.virtual_end);
+    }
+    out.put("}}");
+}
+
+/**
+ * @brief Write a flow start ("s") or finish ("f", bound to the enclosing span) event
+ */
+static void put_trace_flow(BufferedWriter& out, bool& first, int pid, int tid, bool start, long long id,
+                           int order_id, int64_t ts) {
+    put_trace_event(out, first, pid, tid);
+    out.put("\"ph\": \"").put(start ? "s" : "f").put("\", ").put(start ? "" : "\"bp\": \"e\", ")
+       .put("\"cat\": \"order\", \"name\": \"order ").put(order_id).put("\", \"id\": ").put(id)
+       .put(", \"ts\": ").put((long long)ts).put('}');
+}
+
+/**
+ * @brief Name a process (tid 0) or thread track
+ */
+static void put_trace_track_name(BufferedWriter& out, bool& first, int pid, int tid, const std::string& name) {
+    put_trace_event(out, first, pid, tid);
+    out.put(tid == 0 ? "\"ph\": \"M\", \"name\": \"process_name\", \"args\": {\"name\": "
+                     : "\"ph\": \"M\", \"name\": \"thread_name\", \"args\": {\"name\": ");
+    put_json_string(out, name);
+    out.put("}}");
+}
+
+
+/**
+ * @brief Export AGV and line spans as Chrome trace-event JSON (Perfetto / chrome://tracing)
+ * One track per AGV (state spans) and per line (setup/assembly spans), on the wall clock
+ * since the simulation started. Order flows are drawn from each component drop to the
+ * order's assembly, and from the assembly to the pick-up of the finished product.
+ * @param filename Path to the output JSON file
+ * @param timeline Recorded spans
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_chrome_trace(const std::string& filename, const SimTimeline& timeline) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+    const int AGV_PID = 1, LINE_PID = 2;
+    const auto& agvs = timeline.agvs();
+    const auto& lines = timeline.lines();
+
+    out.put("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    bool first = true;
+    put_trace_track_name(out, first, AGV_PID, 0, "AGV fleet");
+    for (size_t i = 0; i < agvs.size(); ++i) put_trace_track_name(out, first, AGV_PID, (int)i + 1, "AGV" + std::to_string(i + 1));
+    put_trace_track_name(out, first, LINE_PID, 0, "Assembly lines");
+    for (size_t i = 0; i < lines.size(); ++i) put_trace_track_name(out, first, LINE_PID, (int)i + 1, "Line " + std::to_string(i + 1));
+
+    struct Assembly { int tid; const TimelineSpan* span; };
+    std::map<int, Assembly> assemblies;     // order_id -> assembly span
+    for (size_t i = 0; i < lines.size(); ++i) {
+        for (const TimelineSpan& span : lines[i]) {
+            put_trace_span(out, first, LINE_PID, (int)i + 1, "line", span);
+            if (std::strcmp(span.name, "assembly") == 0) assemblies[span.order_id] = Assembly{(int)i + 1, &span};
+        }
+    }
+
+    long long flow_id = 0;
+    for (size_t i = 0; i < agvs.size(); ++i) {
+        int tid = (int)i + 1;
+        for (const TimelineSpan& span : agvs[i]) {
+            put_trace_span(out, first, AGV_PID, tid, "agv", span);
+            auto assembly = assemblies.find(span.order_id);
+            if (assembly == assemblies.end()) continue;
+            const TimelineSpan& target = *assembly->second.span;
+            bool component_drop = !span.finished_product && std::strcmp(span.name, "DROPPING") == 0;
+            bool product_pickup = span.finished_product && std::strcmp(span.name, "PICKING") == 0;
+            if (component_drop) {           //Drop -> assembly (flow points sit inside their spans)
+                ++flow_id;
+                put_trace_flow(out, first, AGV_PID, tid, true, flow_id, span.order_id, std::max(span.start_us, span.end_us - 1));
+                put_trace_flow(out, first, LINE_PID, assembly->second.tid, false, flow_id, span.order_id,
+                               std::min(target.start_us + 1, target.end_us));
+            } else if (product_pickup) {    //Assembly -> finished product pick-up
+                ++flow_id;
+                put_trace_flow(out, first, LINE_PID, assembly->second.tid, true, flow_id, span.order_id,
+                               std::max(target.start_us, target.end_us - 1));
+                put_trace_flow(out, first, AGV_PID, tid, false, flow_id, span.order_id, std::min(span.start_us + 1, span.end_us));
+            }
+        }
+    }
+    out.put("\n]}\n");
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+
+/**
+ * @brief Write a two-digit zero-padded clock field (hours may exceed 99)
+ */
+static void put_clock_field(BufferedWriter& out, int value) {
+    if (value < 10) out.put('0');
+    out.put(value);
+}
+
+
+/**
+ * @brief Write orders in the orders file format (read back by read_orders_file)
+ * @param filename Path to the output file
+ * @param orders Orders to write; IDs are not stored, the reader numbers lines
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_orders_file(const std::string& filename, const std::vector<Order>& orders) {
+    BufferedWriter out(filename, 1 << 20);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("# Orders file format: HH MM product_id priority [due HH:MM]\n# Lines starting with # are comments\n\n");
+    for (const Order& order : orders) {
+        put_clock_field(out, order.release_time_minutes / 60);
+        out.put(' ');
+        put_clock_field(out, order.release_time_minutes % 60);
+        out.put(' ').put(order.product_id).put(' ').put(order.priority);
+        if (order.due_date_minutes >= 0) {
+            out.put(' ');
+            put_clock_field(out, order.due_date_minutes / 60);
+            out.put(':');
+            put_clock_field(out, order.due_date_minutes % 60);
+        }
+        out.put('\n');
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write products in the BOM file format (read back by read_bom_file)
+ * @param filename Path to the output file
+ * @param products Products with base time and BOM lines
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_bom_file(const std::string& filename, const std::map<std::string, Product>& products) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("# BOM file format:\n# product_id assembly_base_time_in_minutes\n"
+            "# product_id component_id quantity\n# ...\n");
+    for (const auto& kv : products) {
+        out.put('\n').put(kv.first).put(' ').put(kv.second.base_assembly_time_minutes).put('\n');
+        for (const auto& line : kv.second.bom) {
+            out.put(kv.first).put(' ').put(line.first).put(' ').put(line.second).put('\n');
+        }
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Write initial stock in the warehouse file format (read back by read_warehouse_file)
+ * @param filename Path to the output file
+ * @param inventory Component ID -> initial quantity
+ * @return true if successful, false otherwise
+ */
+bool FileHandler::write_warehouse_file(const std::string& filename, const std::map<std::string, int>& inventory) {
+    BufferedWriter out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    out.put("# Warehouse inventory file format: component_id initial_quantity\n# Lines starting with # are comments\n\n");
+    for (const auto& kv : inventory) {
+        out.put(kv.first).put(' ').put(kv.second).put('\n');
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
 /**
  * @brief Check if a file exists
  * @param filename Path to the file
@@ -210,6 +788,26 @@ bool FileHandler::file_exists(const std::string& filename) {
 }
 
 
+/**
+ * @brief Create a directory (one level) unless it already exists
+ * @param path Directory to create
+ * @return true if the directory exists afterwards
+ */
+bool FileHandler::create_directory(const std::string& path) {
+#ifdef _WIN32
+    int result = _mkdir(path.c_str());
+#else
+    int result = mkdir(path.c_str(), 0755);
+#endif
+    struct stat info;
+    if (result != 0 && (stat(path.c_str(), &info) != 0 || !(info.st_mode & S_IFDIR))) {
+        std::cerr << "Error: Cannot create directory " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
 /**
  * @brief Split a string by a delimiter
  * @param str The input string
@@ -239,4 +837,21 @@ int FileHandler::time_to_minutes(int hour, int minute) {
     return hour * 60 + minute;
 }
 
+/**
+ * @brief Parse a clock token "HH:MM" into minutes
+ * @param token The token to parse
+ * @param minutes Set to the total minutes on success
+ * @return true if the token is a valid clock time, false otherwise
+ */
+bool FileHandler::parse_clock(std::string_view token, int& minutes) {
+    size_t colon = token.find(':');
+    int hour = 0, minute = 0;
+    if (colon == std::string_view::npos || !parse_number(token.substr(0, colon), hour) ||
+        !parse_number(token.substr(colon + 1), minute) || hour < 0 || minute < 0 || minute >= 60) {
+        return false;
+    }
+    minutes = time_to_minutes(hour, minute);
+    return true;
+}
+
 /*************************************************************************************/
\ No newline at end of file
@@ -9,7 +9,13 @@
 /******************************Project Headers*****************************************/
 #include "Order.h"
 #include "Product.h"
+#include "FastSimulator.h"
+#include "ReplicationRunner.h"
+#include "ParameterSweep.h"
+#include "KpiReport.h"
+#include "SimTimeline.h"
 #include <string>
+#include <string_view>
 #include <vector>
 /**************************************************************************************/
 
@@ -26,18 +32,34 @@ public:
     static bool read_bom_file(const std::string& filename, std::map<std::string, Product>& products);
     static bool read_warehouse_file(const std::string& filename, 
                                      std::map<std::string, int>& inventory);
+    static bool parse_order_line(std::string_view line, Order& order, std::string& error);
     
     // Output file writers
-    static bool write_kpi_report(const std::string& filename,
-                                  double avg_lead_time,
-                                  double station_utilization,
-                                  double throughput,
-                                  double agv_utilization);
+    static bool write_kpi_report(const std::string& filename, const KpiReport& kpis);
+    static bool write_kpi_json(const std::string& filename, const KpiReport& kpis);
+    static bool write_order_csv(const std::string& filename, const std::vector<OrderRecord>& records);
+    static bool write_sequence_report(const std::string& filename,
+                                      const FastSimulator& simulator,
+                                      const SequencePlan& plan,
+                                      const FastSimResult& kpis,
+                                      const std::string& header);
+    static bool write_replication_report(const std::string& filename,
+                                         const ReplicationResult& result,
+                                         const std::string& header);
+    static bool write_sweep_results(const std::string& filename,
+                                    const std::vector<SweepInput>& inputs,
+                                    const std::vector<SweepPoint>& points);
+    static bool write_chrome_trace(const std::string& filename, const SimTimeline& timeline);
+    static bool write_orders_file(const std::string& filename, const std::vector<Order>& orders);
+    static bool write_bom_file(const std::string& filename, const std::map<std::string, Product>& products);
+    static bool write_warehouse_file(const std::string& filename, const std::map<std::string, int>& inventory);
     
     // Utility functions
     static bool file_exists(const std::string& filename);
+    static bool create_directory(const std::string& path);
     static std::vector<std::string> split_string(const std::string& str, char delimiter);
     static int time_to_minutes(int hour, int minute);
+    static bool parse_clock(std::string_view token, int& minutes);
 };
 /*************************************************************************************/
 
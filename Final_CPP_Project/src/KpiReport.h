@@ -0,0 +1,116 @@
+/**
+ * @file KpiReport.h
+ * @brief KPI values and per-order results collected at the end of a simulation run
+ */
+
+#ifndef KPI_REPORT_H
+#define KPI_REPORT_H
+
+/*****************************Standard Libraries***************************************/
+#include <array>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/*****************************KPI Structures*******************************************/
+/**
+ * @struct LatenessHistogram
+ * @brief Distribution of lateness (completion - due date) over orders with a due date
+ */
+struct LatenessHistogram {
+    static const int BIN_COUNT = 8;
+    // Upper bounds (minutes, inclusive) of the first BIN_COUNT-1 bins; the last bin is open
+    static constexpr std::array<int, BIN_COUNT - 1> upper_bounds{{-60, -30, 0, 15, 30, 60, 120}};
+    std::array<int, BIN_COUNT> counts{};
+
+    void add(int lateness_minutes) {
+        int bin = 0;
+        while (bin < BIN_COUNT - 1 && lateness_minutes > upper_bounds[bin]) ++bin;
+        counts[bin]++;
+    }
+};
+
+/**
+ * @struct PercentileSummary
+ * @brief Percentiles of a histogram, in minutes
+ */
+struct PercentileSummary {
+    long long count = 0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @struct QueueStats
+ * @brief Time-weighted length of one queue and its Little's-law cross-check
+ */
+struct QueueStats {
+    std::string name;
+    double avg_length = 0.0;        // Time-weighted average
+    long max_length = 0;
+    double arrivals_per_hour = 0.0; // Simulated hours on the AGV clock
+    double mean_time_minutes = -1.0;    // Measured time in the queue (-1 = not measured)
+    double little_length = -1.0;        // arrivals x mean time (-1 = not measured)
+};
+
+/**
+ * @struct OrderRecord
+ * @brief Life cycle of one order (times in simulated minutes, -1 = did not happen)
+ *
+ * Staged and kitted are release time plus AGV-clock time since the order reached
+ * the station; start and completion are line virtual time. The two clocks are
+ * not synchronized (start may precede kitted), so the CSV names the clock in
+ * each milestone column.
+ */
+struct OrderRecord {
+    int order_id = -1;
+    std::string product_id;
+    int parent_order_id = -1;       // Sub-assembly orders only
+    std::string status;             // completed / canceled / pending
+    int release = -1;
+    int due_date = -1;
+    int staged = -1;                // Components reserved, AGV trips requested
+    int kitted = -1;                // Last component unit delivered
+    int start = -1;
+    int completion = -1;
+    int line = -1;
+    int setup_minutes = -1;         // Setup applied before assembly (0 = same product as before)
+    int agv_trips = 0;              // Component deliveries plus the finished-product return
+};
+
+/**
+ * @struct KpiReport
+ * @brief All KPIs written to the report
+ */
+struct KpiReport {
+    double avg_lead_time = 0.0;
+    double station_utilization = 0.0;
+    double throughput = 0.0;
+    double agv_utilization = 0.0;
+
+    // Distributions (HDR histograms recorded during the run)
+    PercentileSummary lead_time;
+    PercentileSummary queue_wait;
+    PercentileSummary kit_preparation;
+    PercentileSummary agv_response;
+
+    // Release control (WIP counts admitted customer orders)
+    int conwip_cap = 0;             // 0 = no CONWIP cap
+    double avg_wip = 0.0;
+    int max_wip = 0;
+
+    // Time-weighted queue lengths
+    std::vector<QueueStats> queues;
+
+    // Due-date performance (orders with a due date only)
+    int orders_with_due_date = 0;
+    int late_orders = 0;
+    double mean_tardiness = 0.0;
+    int max_tardiness = 0;
+    double percent_late = 0.0;
+    LatenessHistogram lateness;
+};
+/*************************************************************************************/
+#endif /* KPI_REPORT_H */
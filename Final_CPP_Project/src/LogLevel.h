@@ -0,0 +1,68 @@
+/**
+ * @file LogLevel.h
+ * @brief Log levels: compiled out below FAS_LOG_LEVEL, checked at runtime above it
+ */
+
+#ifndef LOG_LEVEL_H
+#define LOG_LEVEL_H
+
+/*****************************Standard Libraries***************************************/
+#include <string>
+/*************************************************************************************/
+
+#define FAS_LOG_LEVEL_OFF 0
+#define FAS_LOG_LEVEL_INFO 1     // Order releases/completions, simulation start/stop
+#define FAS_LOG_LEVEL_DIAG 2     // [Diag] messages from the staging, AGV and line hot paths
+
+// Highest level compiled in (set by CMake: -DFAS_LOG_LEVEL=...)
+#ifndef FAS_LOG_LEVEL
+#define FAS_LOG_LEVEL FAS_LOG_LEVEL_DIAG
+#endif
+
+/**
+ * @enum LogLevel
+ * @brief Runtime log level; a message is logged if its level <= the sink's level
+ */
+enum class LogLevel : int {
+    OFF = FAS_LOG_LEVEL_OFF,
+    INFO = FAS_LOG_LEVEL_INFO,
+    DIAG = FAS_LOG_LEVEL_DIAG
+};
+
+inline const char* to_string(LogLevel level) {
+    switch (level) {
+        case LogLevel::OFF: return "off";
+        case LogLevel::INFO: return "info";
+        case LogLevel::DIAG: return "diag";
+    }
+    return "unknown";
+}
+
+inline bool parse_log_level(const std::string& name, LogLevel& level) {
+    if (name == "off") { level = LogLevel::OFF; return true; }
+    if (name == "info") { level = LogLevel::INFO; return true; }
+    if (name == "diag") { level = LogLevel::DIAG; return true; }
+    return false;
+}
+
+/*
+ * FAS_LOG_INFO(sink, call) / FAS_LOG_DIAG(sink, call) run sink->call only if
+ * sink->log_enabled(level). The call, including any message it builds, is not
+ * evaluated when the level is off at runtime, and is not compiled at all when
+ * the level is above FAS_LOG_LEVEL. sink must not be null.
+ *
+ *   FAS_LOG_DIAG(control_center, log_trace(TraceEvent::KIT_COMPLETE, order_id));
+ */
+#if FAS_LOG_LEVEL >= FAS_LOG_LEVEL_INFO
+#define FAS_LOG_INFO(sink, call) do { if ((sink)->log_enabled(LogLevel::INFO)) (sink)->call; } while (0)
+#else
+#define FAS_LOG_INFO(sink, call) ((void)0)
+#endif
+
+#if FAS_LOG_LEVEL >= FAS_LOG_LEVEL_DIAG
+#define FAS_LOG_DIAG(sink, call) do { if ((sink)->log_enabled(LogLevel::DIAG)) (sink)->call; } while (0)
+#else
+#define FAS_LOG_DIAG(sink, call) ((void)0)
+#endif
+
+#endif /* LOG_LEVEL_H */
@@ -0,0 +1,71 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Read-only file mapping implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "MappedFile.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/*************************************************************************************/
+
+/****************************MappedFile Methods***************************************/
+
+/**
+ * @brief Map a file (check is_open() for failure)
+ * @param filename Path of the file
+ */
+MappedFile::MappedFile(const std::string& filename)
+    : data(""), size(0), mapping(nullptr), opened(false) {
+#ifdef _WIN32
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return;
+    char chunk[1 << 16];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) buffer.insert(buffer.end(), chunk, chunk + got);
+    std::fclose(file);
+    data = buffer.empty() ? "" : buffer.data();
+    size = buffer.size();
+    opened = true;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return;
+    }
+    if (info.st_size > 0) {
+        void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            return;
+        }
+        madvise(mapped, (size_t)info.st_size, MADV_SEQUENTIAL);
+        mapping = mapped;
+        data = static_cast<const char*>(mapped);
+        size = (size_t)info.st_size;
+    }
+    ::close(fd);    //The mapping stays valid
+    opened = true;
+#endif
+}
+
+/**
+ * @brief Destructor for MappedFile
+ */
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, size);
+#endif
+}
+/*************************************************************************************/
@@ -0,0 +1,42 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only view of a whole file, memory-mapped where available
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/*****************************Standard Libraries***************************************/
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+/*************************************************************************************/
+
+/****************************MappedFile Class Definition******************************/
+/**
+ * @class MappedFile
+ * @brief Maps a file read-only and exposes it as one string_view
+ *
+ * Parsers walk the view directly, so reading a file costs no copies and no
+ * per-line allocations. On Windows the file is read into a buffer instead.
+ */
+class MappedFile {
+private:
+    const char* data;
+    size_t size;
+    void* mapping;                  // mmap base (nullptr when empty or buffered)
+    std::vector<char> buffer;       // Fallback storage
+    bool opened;
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return opened; }
+    std::string_view view() const { return std::string_view(data, size); }
+};
+/*************************************************************************************/
+#endif /* MAPPED_FILE_H */
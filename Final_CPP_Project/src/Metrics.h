@@ -0,0 +1,219 @@
+/**
+ * @file Metrics.h
+ * @brief Hot-path metrics: constant-memory HDR-style histograms, queue gauges and counters
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+/*****************************Standard Libraries***************************************/
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+/*************************************************************************************/
+
+/****************************HdrHistogram Class Definition****************************/
+/**
+ * @class HdrHistogram
+ * @brief Log-linear histogram of non-negative integers
+ *
+ * Values below 32 get exact buckets; above that every power of two is split
+ * into 16 linear sub-buckets, each 1/16 (6.25%) of its lower edge wide.
+ * Percentiles report the bucket midpoint, so they are within ~3% of the true
+ * value. record() is a relaxed fetch_add, so every thread records into the
+ * same histogram and readers query it once the threads have stopped.
+ */
+class HdrHistogram {
+public:
+    static const int SUB_BUCKETS = 32;                  // Exact buckets for small values
+    static const int HALF = SUB_BUCKETS / 2;
+    static const int BUCKET_COUNT = SUB_BUCKETS + 58 * HALF;  // Covers the whole uint64 range up to 2^63
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max_value;
+
+    static int msb(uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+    }
+
+public:
+    HdrHistogram() { reset(); }
+    HdrHistogram(const HdrHistogram&) = delete;
+    HdrHistogram& operator=(const HdrHistogram&) = delete;
+
+    static int bucket_of(uint64_t value) {
+        if (value < (uint64_t)SUB_BUCKETS) return (int)value;
+        int shift = msb(value) - 4;     //(value >> shift) is in [16, 31]
+        return SUB_BUCKETS + (shift - 1) * HALF + (int)((value >> shift) - HALF);
+    }
+
+    // Lowest value that maps to a bucket
+    static uint64_t bucket_lower(int bucket) {
+        if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+        int shift = (bucket - SUB_BUCKETS) / HALF + 1;
+        uint64_t sub = (uint64_t)((bucket - SUB_BUCKETS) % HALF + HALF);
+        return sub << shift;
+    }
+
+    // Highest value that maps to a bucket
+    static uint64_t bucket_upper(int bucket) {
+        if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+        int shift = (bucket - SUB_BUCKETS) / HALF + 1;
+        uint64_t sub = (uint64_t)((bucket - SUB_BUCKETS) % HALF + HALF);
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void record(int64_t value) {
+        uint64_t v = value > 0 ? (uint64_t)value : 0;
+        counts[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t seen = max_value.load(std::memory_order_relaxed);
+        while (v > seen && !max_value.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {}
+    }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        max_value.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_value.load(std::memory_order_relaxed); }
+    double mean() const { uint64_t n = count(); return n ? (double)sum.load(std::memory_order_relaxed) / n : 0.0; }
+
+    /**
+     * @brief Value at a percentile (midpoint of the bucket, capped by the exact max)
+     * @param percentile In [0, 100]
+     */
+    uint64_t value_at_percentile(double percentile) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t rank = (uint64_t)(percentile / 100.0 * n + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > n) rank = n;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                uint64_t lower = bucket_lower(i);
+                uint64_t middle = lower + (bucket_upper(i) - lower) / 2;
+                return middle < max() ? middle : max();
+            }
+        }
+        return max();
+    }
+};
+/*************************************************************************************/
+
+/****************************TimeWeightedGauge Class Definition***********************/
+/**
+ * @class TimeWeightedGauge
+ * @brief Queue length integrated over time, updated on every enqueue/dequeue
+ *
+ * Lock-free: the area under the level up to time T is T * level - sum(delta_i * t_i)
+ * over all updates, so add() only needs relaxed fetch_adds on the level and on
+ * that weighted sum (plus a CAS for the max), and updates commute. Time is
+ * wall-clock microseconds since reset(); averages do not depend on the unit.
+ * reset() must not race with add().
+ */
+class TimeWeightedGauge {
+private:
+    std::chrono::steady_clock::time_point start;
+    std::atomic<long> level{0};
+    std::atomic<int64_t> weighted_changes{0};   // sum(delta * microseconds since start)
+    std::atomic<long> max_level{0};
+    std::atomic<uint64_t> entries{0};
+
+    int64_t us_since_start(std::chrono::steady_clock::time_point now) const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    }
+
+public:
+    TimeWeightedGauge() : start(std::chrono::steady_clock::now()) {}
+
+    void add(long delta) {
+        int64_t now = us_since_start(std::chrono::steady_clock::now());
+        weighted_changes.fetch_add(delta * now, std::memory_order_relaxed);
+        long updated = level.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if (delta > 0) entries.fetch_add((uint64_t)delta, std::memory_order_relaxed);
+        long seen = max_level.load(std::memory_order_relaxed);
+        while (updated > seen && !max_level.compare_exchange_weak(seen, updated, std::memory_order_relaxed)) {}
+    }
+
+    void reset() {
+        start = std::chrono::steady_clock::now();
+        level.store(0, std::memory_order_relaxed);
+        weighted_changes.store(0, std::memory_order_relaxed);
+        max_level.store(0, std::memory_order_relaxed);
+        entries.store(0, std::memory_order_relaxed);
+    }
+
+    long current() const { return level.load(std::memory_order_relaxed); }
+
+    // Snapshot: time-weighted average level, max level, entries and elapsed milliseconds
+    // (exact once the updating threads have stopped; approximate while they run)
+    void snapshot(double& average, long& maximum, uint64_t& entered, double& elapsed_ms) const {
+        int64_t now = us_since_start(std::chrono::steady_clock::now());
+        double total_area = (double)level.load(std::memory_order_relaxed) * now
+                          - (double)weighted_changes.load(std::memory_order_relaxed);
+        elapsed_ms = now / 1000.0;
+        average = now > 0 ? total_area / now : 0.0;
+        maximum = max_level.load(std::memory_order_relaxed);
+        entered = entries.load(std::memory_order_relaxed);
+    }
+};
+/*************************************************************************************/
+
+/****************************SimMetrics Definition************************************/
+/**
+ * @struct SimMetrics
+ * @brief Histograms recorded while the simulation runs
+ *
+ * Lead time is in simulated minutes (line virtual time). Material-flow times
+ * are measured on the AGV clock (AGV_MS_PER_MINUTE) and recorded in simulated seconds.
+ */
+struct SimMetrics {
+    HdrHistogram lead_time_minutes;      // Release -> completion (customer orders)
+    HdrHistogram queue_wait_seconds;     // Kit complete -> picked by an assembly line
+    HdrHistogram kit_prep_seconds;       // Components reserved -> last unit delivered
+    HdrHistogram agv_response_seconds;   // Unit requested -> accepted by an AGV
+    HdrHistogram system_time_seconds;    // Admitted -> completed (customer orders)
+
+    // Queue lengths over time
+    TimeWeightedGauge order_queue;       // Released, waiting for the staging thread
+    TimeWeightedGauge staging_orders;    // Kits being delivered
+    TimeWeightedGauge pending_units;     // Component units not yet delivered
+    TimeWeightedGauge ready_queue;       // Kitted, waiting for an assembly line
+    TimeWeightedGauge wip;               // Admitted customer orders in the system
+
+    // Progress counters (all orders, including sub-assemblies)
+    std::atomic<uint64_t> orders_released{0};
+    std::atomic<uint64_t> orders_completed{0};
+    std::atomic<uint64_t> orders_canceled{0};
+
+    void reset() {
+        lead_time_minutes.reset();
+        queue_wait_seconds.reset();
+        kit_prep_seconds.reset();
+        agv_response_seconds.reset();
+        system_time_seconds.reset();
+        order_queue.reset();
+        staging_orders.reset();
+        pending_units.reset();
+        ready_queue.reset();
+        wip.reset();
+        orders_released.store(0, std::memory_order_relaxed);
+        orders_completed.store(0, std::memory_order_relaxed);
+        orders_canceled.store(0, std::memory_order_relaxed);
+    }
+};
+/*************************************************************************************/
+#endif /* METRICS_H */
@@ -0,0 +1,226 @@
+/**
+ * @file MetricsServer.cpp
+ * @brief Unix domain socket metrics endpoint implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "MetricsServer.h"
+#include "ControlCenter.h"
+#include "Warehouse.h"
+#include "AGV.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+/*************************************************************************************/
+
+/****************************Exposition Helpers***************************************/
+static void append_header(std::string& out, const char* name, const char* type, const char* help) {
+    out += "# HELP "; out += name; out += ' '; out += help; out += '\n';
+    out += "# TYPE "; out += name; out += ' '; out += type; out += '\n';
+}
+
+static void append_sample(std::string& out, const char* name, const std::string& labels, long long value) {
+    out += name;
+    if (!labels.empty()) { out += '{'; out += labels; out += '}'; }
+    out += ' ';
+    out += std::to_string(value);
+    out += '\n';
+}
+/*************************************************************************************/
+
+/****************************MetricsServer Methods************************************/
+
+/**
+ * @brief Constructor for MetricsServer
+ * @param cc Control center (order counters, queue gauges, simulation clock)
+ * @param wh Warehouse (published stock)
+ * @param fleet AGV fleet (published states)
+ */
+MetricsServer::MetricsServer(ControlCenter* cc, Warehouse* wh, std::vector<AGV*>* fleet)
+    : control_center(cc), warehouse(wh), agv_fleet(fleet), listen_fd(-1), running(false) {
+}
+
+/**
+ * @brief Destructor for MetricsServer
+ */
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+
+/**
+ * @brief Bind the socket and start the server thread
+ * @param path Filesystem path of the Unix domain socket (replaced if it exists)
+ * @return true if the server is listening, false otherwise
+ */
+bool MetricsServer::start(const std::string& path) {
+#ifdef _WIN32
+    std::cerr << "Warning: Metrics socket is not supported on Windows" << std::endl;
+    (void)path;
+    return false;
+#else
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Metrics socket path too long: " << path << std::endl;
+        return false;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        std::cerr << "Error: Cannot create metrics socket" << std::endl;
+        return false;
+    }
+    unlink(path.c_str());   //Stale socket from a previous run
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listen_fd, 4) < 0) {
+        std::cerr << "Error: Cannot bind metrics socket " << path << ": " << std::strerror(errno) << std::endl;
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+    socket_path = path;
+    running = true;
+    server_thread = std::thread(&MetricsServer::serve_loop, this);
+    return true;
+#endif
+}
+
+
+/**
+ * @brief Stop the server thread and remove the socket file
+ */
+void MetricsServer::stop() {
+    running = false;
+    if (server_thread.joinable()) server_thread.join();
+#ifndef _WIN32
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        listen_fd = -1;
+        unlink(socket_path.c_str());
+    }
+#endif
+}
+
+
+/**
+ * @brief Accept loop; polls so that stop() is noticed within 200 ms
+ */
+void MetricsServer::serve_loop() {
+#ifndef _WIN32
+    while (running) {
+        pollfd listener{listen_fd, POLLIN, 0};
+        if (poll(&listener, 1, 200) <= 0) continue;
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) continue;
+        handle_client(client_fd);
+        close(client_fd);
+    }
+#endif
+}
+
+
+/**
+ * @brief Answer one client with the current metrics
+ * @param client_fd Connected client socket
+ */
+void MetricsServer::handle_client(int client_fd) {
+#ifndef _WIN32
+    char request[512];
+    ssize_t received = 0;
+    pollfd client{client_fd, POLLIN, 0};
+    if (poll(&client, 1, 50) > 0) {     //Raw clients send nothing; don't wait for them
+        received = recv(client_fd, request, sizeof(request), 0);
+    }
+    bool http = received >= 4 && std::strncmp(request, "GET ", 4) == 0;
+
+    std::string body = render();
+    std::string response;
+    if (http) {
+        response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                 + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+    }
+    response += body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t n = send(client_fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        sent += (size_t)n;
+    }
+#else
+    (void)client_fd;
+#endif
+}
+
+
+/**
+ * @brief Format the current metrics in Prometheus text exposition format
+ * @return Metrics text
+ */
+std::string MetricsServer::render() const {
+    std::string out;
+    out.reserve(4096);
+
+    if (control_center) {
+        SimMetrics& metrics = control_center->metrics();
+        append_header(out, "fas_sim_time_minutes", "gauge", "Scheduler clock in simulated minutes.");
+        append_sample(out, "fas_sim_time_minutes", "", control_center->get_simulation_time());
+
+        append_header(out, "fas_orders_total", "counter", "Orders by outcome, including sub-assembly orders.");
+        append_sample(out, "fas_orders_total", "state=\"released\"", (long long)metrics.orders_released.load(std::memory_order_relaxed));
+        append_sample(out, "fas_orders_total", "state=\"completed\"", (long long)metrics.orders_completed.load(std::memory_order_relaxed));
+        append_sample(out, "fas_orders_total", "state=\"canceled\"", (long long)metrics.orders_canceled.load(std::memory_order_relaxed));
+
+        append_header(out, "fas_queue_depth", "gauge", "Current queue lengths.");
+        const std::pair<const char*, const TimeWeightedGauge*> queues[] = {
+            {"order_queue", &metrics.order_queue},
+            {"staging_orders", &metrics.staging_orders},
+            {"pending_units", &metrics.pending_units},
+            {"ready_queue", &metrics.ready_queue},
+            {"wip", &metrics.wip},
+        };
+        for (const auto& queue : queues) {
+            append_sample(out, "fas_queue_depth", std::string("queue=\"") + queue.first + "\"", queue.second->current());
+        }
+    }
+
+    if (agv_fleet) {
+        append_header(out, "fas_agv_state", "gauge", "1 for the state each AGV is in.");
+        for (const AGV* agv : *agv_fleet) {
+            AGVState current = agv->peek_state();
+            for (int s = 0; s < AGV_STATE_COUNT; ++s) {
+                AGVState state = static_cast<AGVState>(s);
+                append_sample(out, "fas_agv_state",
+                              "agv=\"" + std::to_string(agv->get_id()) + "\",state=\"" + to_string(state) + "\"",
+                              state == current ? 1 : 0);
+            }
+        }
+        append_header(out, "fas_agv_busy_minutes_total", "counter", "Simulated minutes each AGV spent on tasks.");
+        for (const AGV* agv : *agv_fleet) {
+            append_sample(out, "fas_agv_busy_minutes_total", "agv=\"" + std::to_string(agv->get_id()) + "\"",
+                          agv->busy_time_minutes.load(std::memory_order_relaxed));
+        }
+    }
+
+    if (warehouse) {
+        append_header(out, "fas_inventory_units", "gauge", "Unreserved component stock.");
+        int count = warehouse->published_component_count();
+        for (int i = 0; i < count; ++i) {
+            append_sample(out, "fas_inventory_units", "component=\"" + warehouse->published_component_name(i) + "\"",
+                          warehouse->peek_component_quantity(i));
+        }
+    }
+    return out;
+}
+/*************************************************************************************/
@@ -0,0 +1,56 @@
+/**
+ * @file MetricsServer.h
+ * @brief Live metrics in Prometheus text format over a local Unix domain socket
+ */
+
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+/*****************************Standard Libraries***************************************/
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+/*************************************************************************************/
+
+// Forward declarations
+class ControlCenter;
+class Warehouse;
+class AGV;
+
+/****************************MetricsServer Class Definition***************************/
+/**
+ * @class MetricsServer
+ * @brief Serves one metrics snapshot per connection on a Unix domain socket
+ *
+ * Every value is read from an atomic (progress counters, queue gauges, AGV
+ * states, published stock), so a scrape never takes a simulation lock.
+ * Clients may send an HTTP GET (curl --unix-socket) or nothing at all
+ * (socat/nc -U); HTTP requests get a minimal HTTP/1.0 response.
+ * Not available on Windows: start() returns false.
+ */
+class MetricsServer {
+private:
+    ControlCenter* control_center;
+    Warehouse* warehouse;
+    std::vector<AGV*>* agv_fleet;
+    std::string socket_path;
+    int listen_fd;
+    std::atomic<bool> running;
+    std::thread server_thread;
+
+    void serve_loop();
+    void handle_client(int client_fd);
+
+public:
+    MetricsServer(ControlCenter* cc, Warehouse* wh, std::vector<AGV*>* fleet);
+    ~MetricsServer();
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    bool start(const std::string& path);
+    void stop();
+    std::string render() const;     // Current metrics in Prometheus text format
+};
+/*************************************************************************************/
+#endif /* METRICS_SERVER_H */
@@ -12,6 +12,19 @@
 #include <ctime>
 /*************************************************************************************/
 
+/*****************************Order State Definition***********************************/
+/**
+ * @enum OrderState
+ * @brief Compact (one byte) lifecycle state of an order
+ */
+enum class OrderState : uint8_t {
+    PENDING,
+    RELEASED,
+    COMPLETED,
+    CANCELED
+};
+/*************************************************************************************/
+
 /*****************************Order Structure Definition*******************************/
 struct Order {
     int order_id;              // Unique order identifier
@@ -24,10 +37,11 @@ struct Order {
     int completion_time_minutes;
     bool is_completed;         // Flag indicating if order is completed
     bool is_canceled;          // Flag indicating if order was canceled (e.g., shortage)
+    int parent_order_id;       // Order consuming this sub-assembly, -1 for customer orders
     
     Order() : order_id(0), release_hour(0), release_minute(0), release_time_minutes(0),
               priority(0), due_date_minutes(-1), completion_time_minutes(-1),
-              is_completed(false), is_canceled(false) {}
+              is_completed(false), is_canceled(false), parent_order_id(-1) {}
 };
 /*************************************************************************************/
 #endif /* ORDER_H */
@@ -0,0 +1,241 @@
+/**
+ * @file OrderStream.cpp
+ * @brief Streaming order reader implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "OrderStream.h"
+#include "FileHandler.h"
+#include "TextScan.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cerrno>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/*************************************************************************************/
+
+/****************************OrderStream Methods**************************************/
+
+/**
+ * @brief Constructor for OrderStream
+ * @param capacity Orders parsed ahead of the consumer before the reader stops reading
+ */
+OrderStream::OrderStream(size_t capacity)
+    : ring(capacity > 0 ? capacity : 1), head(0), count(0), ended(false), fd(-1), follow(false),
+      is_fifo(false), running(false), parsed_orders(0), line_number(0), skipping_line(false) {}
+
+/**
+ * @brief Destructor for OrderStream
+ */
+OrderStream::~OrderStream() {
+    close();
+}
+
+
+/**
+ * @brief Open a file or FIFO and start the reader thread
+ * A FIFO may be opened before any writer connects.
+ * @param path Path of the orders file or named pipe
+ * @param follow_file Keep reading a regular file as it grows, until "END"
+ * @return true if the stream was opened
+ */
+bool OrderStream::open(const std::string& path, bool follow_file) {
+#ifdef _WIN32
+    (void)path; (void)follow_file;
+    std::cerr << "Warning: order streaming is not supported on Windows" << std::endl;
+    return false;
+#else
+    close();
+    fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK);   //Do not wait for a FIFO writer here
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open file " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    is_fifo = fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode);
+    filename = path;
+    follow = follow_file;
+    head = 0; count = 0; ended = false;
+    parsed_orders = 0; line_number = 0; skipping_line = false;
+    running = true;
+    reader_thread = std::thread(&OrderStream::reader_loop, this);
+    return true;
+#endif
+}
+
+
+/**
+ * @brief Stop the reader thread and close the file (queued orders are dropped)
+ */
+void OrderStream::close() {
+    running = false;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        not_full.notify_all();
+    }
+    if (reader_thread.joinable()) reader_thread.join();
+#ifndef _WIN32
+    if (fd >= 0) ::close(fd);
+#endif
+    fd = -1;
+}
+
+
+/**
+ * @brief Reader thread: read chunks, parse complete lines, carry the partial one over
+ */
+void OrderStream::reader_loop() {
+#ifndef _WIN32
+    std::vector<char> chunk(CHUNK_SIZE);
+    std::string pending;        //Partial last line of the previous read
+    bool open_stream = true;
+    while (open_stream && running) {
+        struct pollfd descriptor = {fd, POLLIN, 0};
+        int ready = poll(&descriptor, 1, POLL_MS);    //A FIFO without a writer yet is not ready
+        if (ready < 0 && errno != EINTR) break;
+        if (ready <= 0) continue;
+        ssize_t got = ::read(fd, chunk.data(), chunk.size());
+        if (got < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            std::cerr << "Error: Cannot read " << filename << std::endl;
+            break;
+        }
+        if (got == 0) {     //Last FIFO writer closed, or end of a regular file
+            if (is_fifo || !follow) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS));
+            continue;
+        }
+        pending.append(chunk.data(), (size_t)got);
+        open_stream = consume(pending, false);
+    }
+    if (open_stream && running) consume(pending, true);     //Last line without a newline
+#endif
+    finish();
+}
+
+
+/**
+ * @brief Parse the complete lines of pending and keep the partial last line
+ * @param pending Bytes read but not parsed yet
+ * @param at_end No more bytes will follow: parse the partial line too
+ * @return false once the stream is over ("END" or stopped)
+ */
+bool OrderStream::consume(std::string& pending, bool at_end) {
+    if (skipping_line) {    //Rest of an overlong line
+        size_t newline = pending.find('\n');
+        pending.erase(0, newline == std::string::npos ? pending.size() : newline + 1);
+        if (newline == std::string::npos) return true;
+        skipping_line = false;
+    }
+    size_t end = at_end ? pending.size() : pending.rfind('\n');
+    if (end == std::string::npos) {
+        if (pending.size() > MAX_LINE_LENGTH) {     //Keep the carry-over bounded
+            std::cerr << "Warning: " << filename << ":" << ++line_number << ": line longer than "
+                      << MAX_LINE_LENGTH << " bytes, ignored" << std::endl;
+            pending.clear();
+            skipping_line = true;
+        }
+        return true;
+    }
+    if (!at_end) end++;     //Include the newline so blank lines keep their numbers
+    LineReader lines(std::string_view(pending).substr(0, end));
+    std::string_view line;
+    bool open_stream = true;
+    while (open_stream && lines.next(line)) {
+        open_stream = handle_line(line);
+    }
+    pending.erase(0, end);
+    return open_stream;
+}
+
+
+/**
+ * @brief Parse one line and queue the order (blocks while the queue is full)
+ * @return false at the "END" line or when the stream is closed
+ */
+bool OrderStream::handle_line(std::string_view line) {
+    ++line_number;
+    if (is_comment_or_blank(line)) return true;
+    std::string_view tokens[2];
+    if (split_tokens(line, tokens, 2) == 1 && tokens[0] == "END") return false;
+
+    Order order;
+    std::string error;
+    if (!FileHandler::parse_order_line(line, order, error)) {
+        std::cerr << "Warning: " << filename << ":" << line_number << ": " << error << std::endl;
+        return true;
+    }
+    return push(std::move(order));
+}
+
+
+/**
+ * @brief Append an order, waiting for room
+ * @return false if the stream was closed while waiting
+ */
+bool OrderStream::push(Order order) {
+    std::unique_lock<std::mutex> lk(mutex);
+    not_full.wait(lk, [this]{ return count < ring.size() || !running; });
+    if (!running) return false;
+    ring[(head + count) % ring.size()] = std::move(order);
+    count++;
+    parsed_orders.fetch_add(1, std::memory_order_relaxed);
+    not_empty.notify_one();
+    return true;
+}
+
+
+/**
+ * @brief Mark the stream as ended and wake the consumer
+ */
+void OrderStream::finish() {
+    std::lock_guard<std::mutex> lk(mutex);
+    ended = true;
+    not_empty.notify_all();
+}
+
+
+/**
+ * @brief Move up to max_orders queued orders to out, oldest first
+ * @return Number of orders moved
+ */
+size_t OrderStream::pop(std::vector<Order>& out, size_t max_orders) {
+    std::lock_guard<std::mutex> lk(mutex);
+    size_t moved = 0;
+    while (count > 0 && moved < max_orders) {
+        out.push_back(std::move(ring[head]));
+        head = (head + 1) % ring.size();
+        count--;
+        moved++;
+    }
+    if (moved > 0) not_full.notify_one();
+    return moved;
+}
+
+
+/**
+ * @brief Wait until an order is queued or the stream has ended
+ * @return true if an order is queued
+ */
+bool OrderStream::wait(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lk(mutex);
+    not_empty.wait_for(lk, timeout, [this]{ return count > 0 || ended; });
+    return count > 0;
+}
+
+
+/**
+ * @brief True once the reader is done and every order has been popped
+ */
+bool OrderStream::finished() {
+    std::lock_guard<std::mutex> lk(mutex);
+    return ended && count == 0;
+}
+/*************************************************************************************/
@@ -0,0 +1,87 @@
+/**
+ * @file OrderStream.h
+ * @brief Incremental order reader for a growing file or a named pipe
+ */
+
+#ifndef ORDER_STREAM_H
+#define ORDER_STREAM_H
+
+/******************************Project Headers*****************************************/
+#include "Order.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+/*************************************************************************************/
+
+/****************************OrderStream Class Definition*****************************/
+/**
+ * @class OrderStream
+ * @brief Reader thread that parses order lines as they arrive into a bounded queue
+ *
+ * The reader reads fixed-size chunks, parses every complete line with the
+ * orders file syntax and carries a partial last line over to the next read,
+ * so memory stays bounded by the chunk, one line and the queue. When the
+ * queue is full the reader stops reading; a FIFO writer then blocks once the
+ * pipe buffer fills (backpressure). The stream ends at a line "END", when
+ * the last FIFO writer closes, or at the end of a regular file unless it is
+ * followed (tail -f). A line's id=N field is kept in order_id (0 = none);
+ * the consumer assigns the missing IDs. Not available
+ * on Windows: open() returns false.
+ */
+class OrderStream {
+private:
+    static constexpr size_t CHUNK_SIZE = 1 << 16;
+    static constexpr size_t MAX_LINE_LENGTH = 4096;
+    static constexpr int POLL_MS = 50;
+
+    std::vector<Order> ring;                    // Bounded queue of parsed orders
+    size_t head;
+    size_t count;
+    bool ended;                                 // Reader is done (guarded by mutex)
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+
+    std::string filename;
+    int fd;
+    bool follow;                                // Keep reading a regular file past its end
+    bool is_fifo;
+    std::atomic<bool> running;
+    std::atomic<long> parsed_orders;
+    int line_number;                            // Reader thread only
+    bool skipping_line;                         // Dropping the rest of an overlong line
+    std::thread reader_thread;
+
+    void reader_loop();
+    bool consume(std::string& pending, bool at_end);
+    bool handle_line(std::string_view line);
+    bool push(Order order);
+    void finish();
+
+public:
+    explicit OrderStream(size_t capacity = 256);
+    ~OrderStream();
+    OrderStream(const OrderStream&) = delete;
+    OrderStream& operator=(const OrderStream&) = delete;
+
+    bool open(const std::string& path, bool follow_file);
+    void close();
+
+    size_t pop(std::vector<Order>& out, size_t max_orders);    // Never blocks
+    bool wait(std::chrono::milliseconds timeout);               // Until an order is queued or the stream ended
+    bool finished();                                            // Ended and every order popped
+    size_t capacity() const { return ring.size(); }
+    long orders_read() const { return parsed_orders.load(); }
+    const std::string& path() const { return filename; }
+};
+/*************************************************************************************/
+#endif /* ORDER_STREAM_H */
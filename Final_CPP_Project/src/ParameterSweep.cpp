@@ -0,0 +1,84 @@
+/**
+ * @file ParameterSweep.cpp
+ * @brief Parameter sweep implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "ParameterSweep.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <atomic>
+#include <thread>
+/*************************************************************************************/
+
+/****************************ParameterSweep Methods**********************************/
+
+/**
+ * @brief Constructor for ParameterSweep
+ * @param input_sets Input sets to sweep over (must outlive the sweep)
+ * @param sweep_grid Parameter values
+ */
+ParameterSweep::ParameterSweep(const std::vector<SweepInput>& input_sets, const SweepGrid& sweep_grid)
+    : inputs(input_sets), grid(sweep_grid) {
+}
+
+
+/**
+ * @brief Number of worker threads (configured or hardware concurrency)
+ */
+int ParameterSweep::thread_count(size_t configurations) const {
+    int threads = grid.threads;
+    if (threads <= 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = hw > 0 ? (int)hw : 1;
+    }
+    return std::max(1, std::min(threads, (int)configurations));
+}
+
+
+/**
+ * @brief Run every configuration of the grid
+ * @return One point per configuration, in grid order
+ */
+std::vector<SweepPoint> ParameterSweep::run() const {
+    std::vector<SweepPoint> points;
+    for (size_t input = 0; input < inputs.size(); ++input) {
+        for (int agvs : grid.agv_counts) {
+            for (int lines : grid.line_counts) {
+                for (SchedulingPolicy policy : grid.policies) {
+                    SweepPoint point;
+                    point.input_index = (int)input;
+                    point.num_agvs = agvs;
+                    point.num_lines = lines;
+                    point.policy = policy;
+                    points.push_back(point);
+                }
+            }
+        }
+    }
+    if (points.empty()) return points;
+
+    std::atomic<size_t> next_point(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count(points.size()); ++t) {
+        workers.emplace_back([this, &points, &next_point] {
+            for (size_t i = next_point++; i < points.size(); i = next_point++) {
+                SweepPoint& point = points[i];
+                const SweepInput& input = inputs[point.input_index];
+                FastSimConfig config;
+                if (input.image) apply_scenario_layout(input.image->layout(), config);
+                config.num_agvs = point.num_agvs;
+                config.num_lines = point.num_lines;
+                FastSimulator simulator = input.image ? FastSimulator(*input.image, config)
+                                                      : FastSimulator(input.orders, input.products, input.inventory, config);
+                auto rule = make_dispatch_rule(point.policy, simulator.mean_processing_time());
+                point.kpis = simulator.evaluate(*rule);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    return points;
+}
+/*************************************************************************************/
@@ -0,0 +1,79 @@
+/**
+ * @file ParameterSweep.h
+ * @brief Parallel sweep over fleet size, line count, dispatch policy and input set
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+/******************************Project Headers*****************************************/
+#include "FastSimulator.h"
+#include "DispatchRule.h"
+#include "ScenarioImage.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @struct SweepInput
+ * @brief One input set (orders, BOM and inventory read from one directory, or a compiled scenario)
+ */
+struct SweepInput {
+    std::string name;
+    std::vector<Order> orders;
+    std::map<std::string, Product> products;
+    std::map<std::string, int> inventory;
+    std::shared_ptr<const ScenarioImage> image;     // Used instead of the containers when set
+};
+
+/**
+ * @struct SweepGrid
+ * @brief Values of each swept parameter; every combination is run once
+ */
+struct SweepGrid {
+    std::vector<int> agv_counts{10};
+    std::vector<int> line_counts{1};
+    std::vector<SchedulingPolicy> policies{SchedulingPolicy::FIFO};
+    int threads = 0;            // 0 = all hardware threads
+};
+
+/**
+ * @struct SweepPoint
+ * @brief One configuration of the grid and its KPIs
+ */
+struct SweepPoint {
+    int input_index = 0;
+    int num_agvs = 0;
+    int num_lines = 0;
+    SchedulingPolicy policy = SchedulingPolicy::FIFO;
+    FastSimResult kpis;
+};
+
+/****************************ParameterSweep Class Definition**************************/
+/**
+ * @class ParameterSweep
+ * @brief Evaluates every grid configuration with FastSimulator, in parallel
+ *
+ * Configurations are independent, so threads pull them from a shared counter;
+ * inputs are read once and shared read-only. Results are returned in grid
+ * order (input, AGVs, lines, policy) whatever the thread count.
+ */
+class ParameterSweep {
+private:
+    const std::vector<SweepInput>& inputs;
+    SweepGrid grid;
+
+    int thread_count(size_t configurations) const;
+
+public:
+    ParameterSweep(const std::vector<SweepInput>& input_sets, const SweepGrid& sweep_grid);
+
+    std::vector<SweepPoint> run() const;
+};
+/*************************************************************************************/
+#endif /* PARAMETER_SWEEP_H */
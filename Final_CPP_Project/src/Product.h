@@ -25,6 +25,16 @@ struct ComponentRequirement {
 };
 
 
+/**
+ * @struct BomLine
+ * @brief One entry of a compiled (flat) BOM
+ */
+struct BomLine {
+    int component_index;    // Dense index assigned by the Warehouse
+    int quantity;           // Units of this component per product
+};
+
+
 /**
  * @struct Product
  * @brief Represents a product with its BOM and base assembly time
@@ -33,8 +43,12 @@ struct Product {
     std::string product_id;
     int base_assembly_time_minutes;  // T_base in minutes
     std::map<std::string, int> bom;  // component_id -> quantity
+
+    // Compiled at load time by Warehouse::compile_bom; reused for every order
+    std::vector<BomLine> flat_bom;   // Contiguous requirement array
+    int total_units;                 // Sum of all quantities (AGVs carry one unit per trip)
     
-    Product() : base_assembly_time_minutes(0) {}
+    Product() : base_assembly_time_minutes(0), total_units(0) {}
 };
 /*************************************************************************************/
 #endif /* PRODUCT_H */
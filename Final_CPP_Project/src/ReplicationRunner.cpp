@@ -0,0 +1,148 @@
+/**
+ * @file ReplicationRunner.cpp
+ * @brief Monte Carlo replication runner implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "ReplicationRunner.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+/*************************************************************************************/
+
+/****************************ReplicationRunner Methods*******************************/
+
+/**
+ * @brief Constructor for ReplicationRunner
+ * @param sim Evaluator (evaluate() is const and thread-safe)
+ * @param config Replication parameters
+ */
+ReplicationRunner::ReplicationRunner(const FastSimulator& sim, const ReplicationConfig& config)
+    : simulator(sim), cfg(config) {
+    cfg.replications = std::max(1, cfg.replications);
+}
+
+
+/**
+ * @brief Number of worker threads (configured or hardware concurrency)
+ */
+int ReplicationRunner::thread_count() const {
+    int threads = cfg.threads;
+    if (threads <= 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        threads = hw > 0 ? (int)hw : 1;
+    }
+    return std::min(threads, cfg.replications);
+}
+
+
+/**
+ * @brief Run all replications of a plan and estimate each KPI
+ * @param plan Staging sequence and line assignment, the same in every replication
+ * @return Per-replication KPIs and estimates with confidence intervals
+ */
+ReplicationResult ReplicationRunner::run(const SequencePlan& plan) const {
+    ReplicationResult result;
+    result.runs.resize(cfg.replications);
+
+    std::atomic<int> next_replication(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count(); ++t) {
+        workers.emplace_back([this, &plan, &result, &next_replication] {
+            for (int r = next_replication++; r < cfg.replications; r = next_replication++) {
+                FastRng rng(cfg.seed, (uint64_t)r);
+                result.runs[r] = simulator.evaluate(plan, &rng);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    const std::pair<const char*, double (*)(const FastSimResult&)> kpis[] = {
+        {"Average Lead Time (min)", [](const FastSimResult& k) { return k.avg_lead_time; }},
+        {"Makespan (min)", [](const FastSimResult& k) { return (double)k.makespan_minutes; }},
+        {"Throughput (orders/h)", [](const FastSimResult& k) { return k.throughput; }},
+        {"Station Utilization (%)", [](const FastSimResult& k) { return k.station_utilization * 100; }},
+        {"AGV Utilization (%)", [](const FastSimResult& k) { return k.agv_utilization * 100; }},
+        {"Total Tardiness (min)", [](const FastSimResult& k) { return (double)k.total_tardiness; }},
+        {"Late Orders", [](const FastSimResult& k) { return (double)k.late_orders; }},
+    };
+    std::vector<double> samples(cfg.replications);
+    for (const auto& kpi : kpis) {
+        for (int r = 0; r < cfg.replications; ++r) samples[r] = kpi.second(result.runs[r]);
+        result.estimates.push_back(estimate(kpi.first, samples, cfg.confidence));
+    }
+    return result;
+}
+
+
+/**
+ * @brief Mean, standard deviation and confidence half-width of a sample
+ * @param name KPI name
+ * @param samples One value per replication
+ * @param confidence Two-sided confidence level
+ */
+KpiEstimate ReplicationRunner::estimate(const std::string& name, const std::vector<double>& samples, double confidence) {
+    KpiEstimate e;
+    e.name = name;
+    if (samples.empty()) return e;
+    double sum = 0.0;
+    e.min = e.max = samples[0];
+    for (double x : samples) {
+        sum += x;
+        e.min = std::min(e.min, x);
+        e.max = std::max(e.max, x);
+    }
+    int n = (int)samples.size();
+    e.mean = sum / n;
+    if (n < 2) return e;
+    double squares = 0.0;
+    for (double x : samples) squares += (x - e.mean) * (x - e.mean);
+    e.stddev = std::sqrt(squares / (n - 1));
+    e.half_width = student_t_quantile(0.5 + confidence / 2, n - 1) * e.stddev / std::sqrt((double)n);
+    return e;
+}
+
+
+/**
+ * @brief Quantile of Student's t distribution
+ * Normal quantile (Acklam's rational approximation) corrected with the
+ * Cornish-Fisher expansion in 1/df (within 1% of tables for df >= 3);
+ * closed forms for df = 1 and 2.
+ * @param probability Lower-tail probability in (0, 1)
+ * @param degrees_of_freedom Degrees of freedom (>= 1)
+ */
+double ReplicationRunner::student_t_quantile(double probability, int degrees_of_freedom) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    double p = std::min(std::max(probability, 1e-12), 1 - 1e-12);
+    if (degrees_of_freedom <= 1) return std::tan(3.141592653589793 * (p - 0.5));
+    if (degrees_of_freedom == 2) return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    double z;
+    if (p < 0.02425 || p > 1 - 0.02425) {
+        double q = std::sqrt(-2 * std::log(p < 0.5 ? p : 1 - p));
+        z = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        if (p > 0.5) z = -z;
+    } else {
+        double q = p - 0.5, r = q * q;
+        z = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    }
+
+    double v = degrees_of_freedom;
+    double z2 = z * z;
+    return z + z * (z2 + 1) / (4 * v)
+             + z * ((5 * z2 + 16) * z2 + 3) / (96 * v * v)
+             + z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / (384 * v * v * v);
+}
+/*************************************************************************************/
@@ -0,0 +1,76 @@
+/**
+ * @file ReplicationRunner.h
+ * @brief Monte Carlo replications of the fast cell model with confidence intervals
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+/******************************Project Headers*****************************************/
+#include "FastSimulator.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @struct ReplicationConfig
+ * @brief Number of replications, parallelism and confidence level
+ */
+struct ReplicationConfig {
+    int replications = 30;
+    int threads = 0;            // 0 = all hardware threads
+    uint64_t seed = 1;          // Replication r uses stream r of this seed
+    double confidence = 0.95;   // Two-sided confidence level of the intervals
+};
+
+/**
+ * @struct KpiEstimate
+ * @brief Sample statistics of one KPI over all replications
+ */
+struct KpiEstimate {
+    std::string name;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double half_width = 0.0;    // Confidence interval is mean +/- half_width
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @struct ReplicationResult
+ * @brief Per-replication KPIs and their estimates
+ */
+struct ReplicationResult {
+    std::vector<FastSimResult> runs;    // Indexed by replication
+    std::vector<KpiEstimate> estimates;
+};
+
+/****************************ReplicationRunner Class Definition***********************/
+/**
+ * @class ReplicationRunner
+ * @brief Runs independent replications of one plan on all cores
+ *
+ * Threads pull replication indices from a shared counter; each replication
+ * owns its FastRng, so the results do not depend on the thread count.
+ * Intervals use Student's t with replications - 1 degrees of freedom.
+ */
+class ReplicationRunner {
+private:
+    const FastSimulator& simulator;
+    ReplicationConfig cfg;
+
+    int thread_count() const;
+
+public:
+    ReplicationRunner(const FastSimulator& sim, const ReplicationConfig& config);
+
+    ReplicationResult run(const SequencePlan& plan) const;
+    static KpiEstimate estimate(const std::string& name, const std::vector<double>& samples, double confidence);
+    static double student_t_quantile(double probability, int degrees_of_freedom);
+};
+/*************************************************************************************/
+#endif /* REPLICATION_RUNNER_H */
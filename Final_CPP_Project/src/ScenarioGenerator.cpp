@@ -0,0 +1,217 @@
+/**
+ * @file ScenarioGenerator.cpp
+ * @brief Synthetic scenario generator implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "ScenarioGenerator.h"
+#include "BomExplosion.h"
+#include "FastRng.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <cmath>
+#include <utility>
+/*************************************************************************************/
+
+namespace {
+
+/**
+ * @brief Uniform integer in [low, high]
+ */
+int uniform_int(FastRng& rng, int low, int high) {
+    return std::min(high, low + (int)(rng.uniform() * (high - low + 1)));
+}
+
+/**
+ * @brief Move count distinct random entries of pool to its front (partial Fisher-Yates)
+ */
+void pick_distinct(FastRng& rng, std::vector<int>& pool, int count) {
+    for (int i = 0; i < count; ++i) {
+        std::swap(pool[i], pool[uniform_int(rng, i, (int)pool.size() - 1)]);
+    }
+}
+
+/**
+ * @brief Product ID of sub-assembly index at a BOM level (level 0 = customer products)
+ */
+std::string product_name(int level, int index) {
+    if (level == 0) return "P" + std::to_string(index + 1);
+    return "PL" + std::to_string(level + 1) + "_" + std::to_string(index + 1);
+}
+
+} // namespace
+
+/****************************ScenarioGenerator Methods*******************************/
+
+/**
+ * @brief Check that the config describes a scenario that can be generated
+ * @param error Set to the first problem found
+ * @return true if generate() can be called
+ */
+bool ScenarioGenerator::validate(std::string& error) const {
+    if (cfg.orders < 0) error = "--orders must not be negative";
+    else if (cfg.products < 1) error = "--products must be at least 1";
+    else if (cfg.components < 1) error = "--components must be at least 1";
+    else if (cfg.bom_width < 0 || cfg.bom_width > cfg.components) error = "--bom-width must be between 0 and --components";
+    else if (cfg.bom_depth < 1) error = "--bom-depth must be at least 1";
+    else if (cfg.subassembly_width < 0 || cfg.subassembly_width > cfg.products) error = "--subassemblies must be between 0 and --products";
+    else if (cfg.bom_width == 0 && (cfg.bom_depth == 1 || cfg.subassembly_width == 0)) error = "products need at least one BOM line";
+    else if (cfg.max_quantity < 1) error = "--max-quantity must be at least 1";
+    else if (cfg.min_base_time < 0 || cfg.max_base_time < cfg.min_base_time) error = "invalid --base-time range";
+    else if (cfg.arrival_rate <= 0.0) error = "--rate must be positive";
+    else if (cfg.burst_size < 1) error = "--burst-size must be at least 1";
+    else if (cfg.priority_levels < 1) error = "--priorities must be at least 1";
+    else if (cfg.due_fraction < 0.0 || cfg.due_fraction > 1.0) error = "--due-fraction must be between 0 and 1";
+    else if (cfg.due_slack_min < 0.0 || cfg.due_slack_max < cfg.due_slack_min) error = "invalid --due-slack range";
+    else if (cfg.stock_factor < 0.0) error = "--stock-factor must not be negative";
+    else return true;
+    return false;
+}
+
+
+/**
+ * @brief Generate products, orders and inventory
+ * @param orders Filled with the orders, IDs 1..n in release order
+ * @param products Filled with every product and sub-assembly
+ * @param inventory Filled with the initial stock of every raw component
+ */
+void ScenarioGenerator::generate(std::vector<Order>& orders, std::map<std::string, Product>& products,
+                                 std::map<std::string, int>& inventory) const {
+    // Products, level by level; only levels above the last use sub-assemblies
+    FastRng bom_rng(cfg.seed, 0);
+    std::vector<int> component_pool(cfg.components);
+    for (int i = 0; i < cfg.components; ++i) component_pool[i] = i;
+    std::vector<int> product_pool(cfg.products);
+    for (int i = 0; i < cfg.products; ++i) product_pool[i] = i;
+    for (int level = 0; level < cfg.bom_depth; ++level) {
+        for (int index = 0; index < cfg.products; ++index) {
+            Product product;
+            product.product_id = product_name(level, index);
+            product.base_assembly_time_minutes = uniform_int(bom_rng, cfg.min_base_time, cfg.max_base_time);
+            pick_distinct(bom_rng, component_pool, cfg.bom_width);
+            for (int k = 0; k < cfg.bom_width; ++k) {
+                product.bom["C" + std::to_string(component_pool[k] + 1)] = uniform_int(bom_rng, 1, cfg.max_quantity);
+            }
+            if (level + 1 < cfg.bom_depth) {
+                pick_distinct(bom_rng, product_pool, cfg.subassembly_width);
+                for (int k = 0; k < cfg.subassembly_width; ++k) product.bom[product_name(level + 1, product_pool[k])] = 1;
+            }
+            products[product.product_id] = product;
+        }
+    }
+
+    // Nominal work of one unit (its own assembly plus every sub-assembly), deepest level first
+    std::map<std::string, int> work;
+    for (int level = cfg.bom_depth - 1; level >= 0; --level) {
+        for (int index = 0; index < cfg.products; ++index) {
+            const Product& product = products[product_name(level, index)];
+            int total = product.base_assembly_time_minutes;
+            for (const auto& line : product.bom) {
+                auto child = work.find(line.first);
+                if (child != work.end()) total += child->second * line.second;
+            }
+            work[product.product_id] = total;
+        }
+    }
+
+    // Orders
+    FastRng order_rng(cfg.seed, 1);
+    std::vector<long long> orders_per_product(cfg.products, 0);
+    double minutes_per_order = 60.0 / cfg.arrival_rate;
+    double clock = cfg.start_minutes;
+    int burst_left = 0;
+    orders.clear();
+    orders.reserve(cfg.orders);
+    for (int i = 0; i < cfg.orders; ++i) {
+        switch (cfg.arrivals) {
+            case ArrivalProcess::POISSON:
+                if (i > 0) clock += -std::log(1.0 - order_rng.uniform()) * minutes_per_order;
+                break;
+            case ArrivalProcess::UNIFORM:
+                clock = cfg.start_minutes + i * minutes_per_order;
+                break;
+            case ArrivalProcess::BURST:
+                if (burst_left == 0) {
+                    if (i > 0) clock += -std::log(1.0 - order_rng.uniform()) * minutes_per_order * cfg.burst_size;
+                    burst_left = cfg.burst_size;
+                }
+                burst_left--;
+                break;
+        }
+        int product = uniform_int(order_rng, 0, cfg.products - 1);
+        orders_per_product[product]++;
+
+        Order order;
+        order.order_id = i + 1;
+        order.release_time_minutes = (int)clock;
+        order.release_hour = order.release_time_minutes / 60;
+        order.release_minute = order.release_time_minutes % 60;
+        order.product_id = product_name(0, product);
+        if (cfg.priorities == PriorityDistribution::SKEWED) {
+            order.priority = 1;
+            while (order.priority < cfg.priority_levels && order_rng.uniform() < 0.5) order.priority++;
+        } else {
+            order.priority = uniform_int(order_rng, 1, cfg.priority_levels);
+        }
+        if (order_rng.uniform() < cfg.due_fraction) {
+            double slack = cfg.due_slack_min + order_rng.uniform() * (cfg.due_slack_max - cfg.due_slack_min);
+            order.due_date_minutes = order.release_time_minutes + (int)std::lround(slack * work[order.product_id]);
+        }
+        orders.push_back(std::move(order));
+    }
+
+    // Inventory: stock_factor x exploded raw demand, every component listed
+    BomExplosion explosion;
+    std::string error;
+    explosion.build(products, error);   //Generated BOMs are acyclic: levels only point down
+    std::map<std::string, long long> demand;
+    for (int index = 0; index < cfg.products; ++index) {
+        for (const auto& raw : explosion.raw_requirements(product_name(0, index))) {
+            demand[raw.first] += raw.second * orders_per_product[index];
+        }
+    }
+    for (int i = 0; i < cfg.components; ++i) {
+        std::string id = "C" + std::to_string(i + 1);
+        double stock = std::ceil(cfg.stock_factor * demand[id]);
+        inventory[id] = (int)std::min(stock, 2147483647.0);
+    }
+}
+/*************************************************************************************/
+
+const char* to_string(ArrivalProcess arrivals) {
+    switch (arrivals) {
+        case ArrivalProcess::UNIFORM: return "UNIFORM";
+        case ArrivalProcess::BURST: return "BURST";
+        case ArrivalProcess::POISSON: break;
+    }
+    return "POISSON";
+}
+
+/**
+ * @brief Parse an arrival process name (poisson, uniform, burst)
+ * @return false if the name is unknown
+ */
+bool parse_arrival_process(const std::string& name, ArrivalProcess& arrivals) {
+    if (name == "poisson") arrivals = ArrivalProcess::POISSON;
+    else if (name == "uniform") arrivals = ArrivalProcess::UNIFORM;
+    else if (name == "burst") arrivals = ArrivalProcess::BURST;
+    else return false;
+    return true;
+}
+
+const char* to_string(PriorityDistribution priorities) {
+    return priorities == PriorityDistribution::SKEWED ? "SKEWED" : "UNIFORM";
+}
+
+/**
+ * @brief Parse a priority distribution name (uniform, skewed)
+ * @return false if the name is unknown
+ */
+bool parse_priority_distribution(const std::string& name, PriorityDistribution& priorities) {
+    if (name == "uniform") priorities = PriorityDistribution::UNIFORM;
+    else if (name == "skewed") priorities = PriorityDistribution::SKEWED;
+    else return false;
+    return true;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ScenarioGenerator.h
+ * @brief Reproducible synthetic scenarios (orders, multi-level BOM, inventory) for stress runs
+ */
+
+#ifndef SCENARIO_GENERATOR_H
+#define SCENARIO_GENERATOR_H
+
+/******************************Project Headers*****************************************/
+#include "Order.h"
+#include "Product.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @enum ArrivalProcess
+ * @brief How order release times are spaced
+ */
+enum class ArrivalProcess {
+    POISSON,        // Exponential inter-arrival times at the given rate
+    UNIFORM,        // Evenly spaced at the given rate
+    BURST           // Poisson bursts of burst_size orders with the same release time
+};
+
+/**
+ * @enum PriorityDistribution
+ * @brief How order priorities (1 = lowest) are drawn
+ */
+enum class PriorityDistribution {
+    UNIFORM,        // Every level equally likely
+    SKEWED          // Each level half as likely as the one below it
+};
+
+/**
+ * @struct GeneratorConfig
+ * @brief Shape of a synthetic scenario; the same config and seed give the same files
+ */
+struct GeneratorConfig {
+    uint64_t seed = 1;
+    int orders = 1000;
+    int products = 10;                  // Customer products P1..Pn
+    int components = 100;               // Raw components C1..Cm
+    int bom_width = 5;                  // Raw components per product (every BOM level)
+    int bom_depth = 1;                  // BOM levels; 1 = flat, each further level adds n sub-assemblies
+    int subassembly_width = 1;          // Sub-assemblies per product above the last level
+    int max_quantity = 4;               // Units per raw BOM line, drawn from 1..max
+    int min_base_time = 20;             // Assembly time range in minutes
+    int max_base_time = 60;
+
+    ArrivalProcess arrivals = ArrivalProcess::POISSON;
+    double arrival_rate = 1.0;          // Orders per hour
+    int burst_size = 10;
+    int start_minutes = 8 * 60;         // Release time of the first order
+
+    int priority_levels = 3;
+    PriorityDistribution priorities = PriorityDistribution::UNIFORM;
+    double due_fraction = 1.0;          // Share of orders with a due date
+    double due_slack_min = 2.0;         // Due = release + slack x nominal assembly work,
+    double due_slack_max = 6.0;         // slack drawn uniformly from [min, max]
+
+    double stock_factor = 1.2;          // Stock = factor x raw demand of the generated orders
+};
+
+/****************************ScenarioGenerator Class Definition***********************/
+/**
+ * @class ScenarioGenerator
+ * @brief Builds products, orders and inventory from a GeneratorConfig
+ *
+ * Products and their BOMs are drawn first, then orders, each from its own
+ * FastRng stream, so changing the order count keeps the product set.
+ * Inventory is sized from the exploded raw-component demand of the orders,
+ * so stock_factor < 1 produces shortages.
+ */
+class ScenarioGenerator {
+private:
+    GeneratorConfig cfg;
+
+public:
+    explicit ScenarioGenerator(const GeneratorConfig& config) : cfg(config) {}
+
+    bool validate(std::string& error) const;
+    void generate(std::vector<Order>& orders, std::map<std::string, Product>& products,
+                  std::map<std::string, int>& inventory) const;
+};
+
+const char* to_string(ArrivalProcess arrivals);
+bool parse_arrival_process(const std::string& name, ArrivalProcess& arrivals);
+const char* to_string(PriorityDistribution priorities);
+bool parse_priority_distribution(const std::string& name, PriorityDistribution& priorities);
+/*************************************************************************************/
+#endif /* SCENARIO_GENERATOR_H */
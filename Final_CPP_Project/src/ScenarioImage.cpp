@@ -0,0 +1,252 @@
+/**
+ * @file ScenarioImage.cpp
+ * @brief Scenario compiler and loader implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "ScenarioImage.h"
+#include "BufferedWriter.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstring>
+#include <iostream>
+/*************************************************************************************/
+
+namespace {
+
+const char SCENARIO_MAGIC[8] = {'F', 'A', 'S', 'S', 'C', 'E', 'N', 'E'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+size_t align8(size_t offset) { return (offset + 7) & ~(size_t)7; }
+
+/**
+ * @brief Check that count records of record_size bytes fit in the file at an aligned offset
+ */
+bool section_fits(const ScenarioSection& s, size_t record_size, size_t file_size) {
+    if (s.offset % 8 != 0 || s.offset > file_size) return false;
+    return s.count <= (file_size - s.offset) / record_size;
+}
+
+/**
+ * @brief Write a section's records, then zero padding up to the next section
+ */
+template <typename T>
+void put_section(BufferedWriter& out, const std::vector<T>& records, size_t& written) {
+    static const char zeros[8] = {0};
+    if (!records.empty()) out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    written += records.size() * sizeof(T);
+    out.write(zeros, align8(written) - written);
+    written = align8(written);
+}
+
+} // namespace
+
+/****************************ScenarioImage Methods************************************/
+
+/**
+ * @brief Compile parsed inputs into a scenario image file
+ * @param filename Output path
+ * @param orders Orders as read from orders.txt
+ * @param products Products as read from bom.txt
+ * @param inventory Initial stock as read from warehouse.txt
+ * @param layout Fleet, lines and nominal times
+ * @return true if the file was written
+ */
+bool ScenarioImage::compile(const std::string& filename,
+                            const std::vector<Order>& orders,
+                            const std::map<std::string, Product>& products,
+                            const std::map<std::string, int>& inventory,
+                            const ScenarioLayout& layout) {
+    std::string names;
+    std::map<std::string, ScenarioName> interned;
+    auto intern = [&names, &interned](const std::string& text) {
+        auto it = interned.find(text);
+        if (it != interned.end()) return it->second;
+        ScenarioName name{(uint32_t)names.size(), (uint32_t)text.size()};
+        names += text;
+        interned[text] = name;
+        return name;
+    };
+
+    std::map<std::string, uint32_t> component_index;    //Same numbering as FastSimulator
+    std::vector<ScenarioComponent> component_records;
+    auto index_of = [&](const std::string& id) {
+        auto it = component_index.find(id);
+        if (it != component_index.end()) return it->second;
+        uint32_t index = (uint32_t)component_records.size();
+        component_index[id] = index;
+        component_records.push_back(ScenarioComponent{intern(id), 0, 0});
+        return index;
+    };
+
+    std::vector<ScenarioProduct> product_records;
+    std::vector<ScenarioBomEntry> bom_records;
+    std::map<std::string, int> product_index;
+    for (const auto& kv : products) {
+        product_index[kv.first] = (int)product_records.size();
+        product_records.push_back(ScenarioProduct{intern(kv.first), kv.second.base_assembly_time_minutes,
+                                                  (uint32_t)bom_records.size(), (uint32_t)kv.second.bom.size(), 0});
+        for (const auto& comp : kv.second.bom) {
+            bom_records.push_back(ScenarioBomEntry{index_of(comp.first), comp.second});
+        }
+    }
+    for (const auto& kv : inventory) {
+        ScenarioComponent& component = component_records[index_of(kv.first)];
+        component.initial_stock = kv.second;
+        component.stocked = 1;
+    }
+
+    std::vector<ScenarioOrder> order_records;
+    order_records.reserve(orders.size());
+    for (const auto& order : orders) {
+        auto it = product_index.find(order.product_id);
+        order_records.push_back(ScenarioOrder{order.order_id, order.release_time_minutes, order.due_date_minutes,
+                                              order.priority, it != product_index.end() ? it->second : -1,
+                                              intern(order.product_id), 0});
+    }
+
+    ScenarioHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SCENARIO_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.layout = layout;
+    size_t end = align8(sizeof(ScenarioHeader));
+    auto place = [&end](ScenarioSection& s, size_t count, size_t record_size) {
+        s.offset = end;
+        s.count = count;
+        end = align8(end + count * record_size);
+    };
+    place(header.orders, order_records.size(), sizeof(ScenarioOrder));
+    place(header.products, product_records.size(), sizeof(ScenarioProduct));
+    place(header.bom, bom_records.size(), sizeof(ScenarioBomEntry));
+    place(header.components, component_records.size(), sizeof(ScenarioComponent));
+    place(header.names, names.size(), 1);
+    header.file_size = end;
+
+    BufferedWriter out(filename, 1 << 20);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+    size_t written = 0;
+    put_section(out, std::vector<ScenarioHeader>{header}, written);
+    put_section(out, order_records, written);
+    put_section(out, product_records, written);
+    put_section(out, bom_records, written);
+    put_section(out, component_records, written);
+    put_section(out, std::vector<char>(names.begin(), names.end()), written);
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Map a scenario image and check it
+ * @param filename Path of the image
+ * @return true if the image is valid
+ */
+bool ScenarioImage::open(const std::string& filename) {
+    header = nullptr;
+    file.reset(new MappedFile(filename));
+    if (!file->is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        file.reset();
+        return false;
+    }
+    std::string_view bytes = file->view();
+    if (bytes.size() < sizeof(ScenarioHeader) || std::memcmp(bytes.data(), SCENARIO_MAGIC, sizeof(SCENARIO_MAGIC)) != 0) {
+        std::cerr << "Error: " << filename << " is not a scenario image" << std::endl;
+        file.reset();
+        return false;
+    }
+    header = reinterpret_cast<const ScenarioHeader*>(bytes.data());
+    if (header->byte_order != BYTE_ORDER_MARK || header->version != VERSION) {
+        std::cerr << "Error: " << filename << " is a version " << header->version << " or foreign byte order scenario "
+                  << "image (expected version " << VERSION << "); recompile it" << std::endl;
+        header = nullptr;
+        file.reset();
+        return false;
+    }
+    if (!validate(filename)) {
+        header = nullptr;
+        file.reset();
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Check section bounds and every cross-reference once, so accessors need no checks
+ */
+bool ScenarioImage::validate(const std::string& filename) const {
+    size_t size = file->view().size();
+    bool valid = header->file_size == size &&
+                 section_fits(header->orders, sizeof(ScenarioOrder), size) &&
+                 section_fits(header->products, sizeof(ScenarioProduct), size) &&
+                 section_fits(header->bom, sizeof(ScenarioBomEntry), size) &&
+                 section_fits(header->components, sizeof(ScenarioComponent), size) &&
+                 section_fits(header->names, 1, size);
+    auto name_fits = [this](const ScenarioName& n) {
+        return n.offset <= header->names.count && n.length <= header->names.count - n.offset;
+    };
+    for (size_t i = 0; valid && i < order_count(); ++i) {
+        const ScenarioOrder& order = orders()[i];
+        valid = name_fits(order.product_id) && order.product_index >= -1 && order.product_index < (int64_t)product_count();
+    }
+    for (size_t i = 0; valid && i < product_count(); ++i) {
+        const ScenarioProduct& product = products()[i];
+        valid = name_fits(product.product_id) && product.bom_first <= header->bom.count &&
+                product.bom_count <= header->bom.count - product.bom_first;
+    }
+    for (size_t i = 0; valid && i < header->bom.count; ++i) {
+        valid = bom()[i].component < component_count();
+    }
+    for (size_t i = 0; valid && i < component_count(); ++i) {
+        valid = name_fits(components()[i].component_id);
+    }
+    if (!valid) {
+        std::cerr << "Error: " << filename << " is a damaged scenario image" << std::endl;
+    }
+    return valid;
+}
+
+
+/**
+ * @brief Rebuild the orders, products and inventory the text readers would produce
+ */
+void ScenarioImage::load(std::vector<Order>& order_list, std::map<std::string, Product>& product_map,
+                         std::map<std::string, int>& inventory) const {
+    order_list.reserve(order_list.size() + order_count());
+    for (size_t i = 0; i < order_count(); ++i) {
+        const ScenarioOrder& record = orders()[i];
+        Order order;
+        order.order_id = record.order_id;
+        order.release_time_minutes = record.release_time_minutes;
+        order.release_hour = record.release_time_minutes / 60;
+        order.release_minute = record.release_time_minutes % 60;
+        order.product_id = std::string(name(record.product_id));
+        order.priority = record.priority;
+        order.due_date_minutes = record.due_date_minutes;
+        order_list.push_back(std::move(order));
+    }
+    for (size_t i = 0; i < product_count(); ++i) {
+        const ScenarioProduct& record = products()[i];
+        Product& product = product_map[std::string(name(record.product_id))];
+        product.product_id = std::string(name(record.product_id));
+        product.base_assembly_time_minutes = record.base_time_minutes;
+        for (uint32_t b = record.bom_first; b < record.bom_first + record.bom_count; ++b) {
+            product.bom[std::string(name(components()[bom()[b].component].component_id))] = bom()[b].quantity;
+        }
+    }
+    for (size_t i = 0; i < component_count(); ++i) {
+        const ScenarioComponent& record = components()[i];
+        if (record.stocked) inventory[std::string(name(record.component_id))] = record.initial_stock;
+    }
+}
+/*************************************************************************************/
@@ -0,0 +1,156 @@
+/**
+ * @file ScenarioImage.h
+ * @brief Precompiled binary scenario (orders, BOM, inventory, layout) loaded by mapping
+ */
+
+#ifndef SCENARIO_IMAGE_H
+#define SCENARIO_IMAGE_H
+
+/******************************Project Headers*****************************************/
+#include "Order.h"
+#include "Product.h"
+#include "MappedFile.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+/*************************************************************************************/
+
+/*
+ * File layout (version 1, native little-endian, every section 8-byte aligned):
+ *   ScenarioHeader | ScenarioOrder[] | ScenarioProduct[] | ScenarioBomEntry[] |
+ *   ScenarioComponent[] | name bytes
+ * Products are sorted by ID. Components are numbered in the order FastSimulator
+ * indexes them: BOM items of each product first, then inventory-only items.
+ * Names are (offset, length) slices of the name bytes.
+ */
+
+/**
+ * @struct ScenarioLayout
+ * @brief Cell layout: fleet, lines and nominal AGV/line times
+ */
+struct ScenarioLayout {
+    int32_t num_agvs;
+    int32_t num_lines;
+    int32_t setup_time_minutes;
+    int32_t travel_time_warehouse_minutes;
+    int32_t travel_time_station_minutes;
+    int32_t picking_time_minutes;
+    int32_t dropping_time_minutes;
+    int32_t return_time_minutes;
+};
+
+struct ScenarioName {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct ScenarioOrder {
+    int32_t order_id;
+    int32_t release_time_minutes;
+    int32_t due_date_minutes;           // -1 = none
+    int32_t priority;
+    int32_t product_index;              // -1 if the product has no BOM entry
+    ScenarioName product_id;
+    int32_t reserved;
+};
+
+struct ScenarioProduct {
+    ScenarioName product_id;
+    int32_t base_time_minutes;
+    uint32_t bom_first;                 // First ScenarioBomEntry of the product
+    uint32_t bom_count;
+    int32_t reserved;
+};
+
+struct ScenarioBomEntry {
+    uint32_t component;                 // ScenarioComponent index (may name a sub-assembly product)
+    int32_t quantity;
+};
+
+struct ScenarioComponent {
+    ScenarioName component_id;
+    int32_t initial_stock;
+    int32_t stocked;                    // 1 if listed in the inventory, 0 if only referenced by a BOM
+};
+
+struct ScenarioSection {
+    uint64_t offset;
+    uint64_t count;                     // Records (bytes for the names section)
+};
+
+struct ScenarioHeader {
+    char magic[8];                      // "FASSCENE"
+    uint32_t version;
+    uint32_t byte_order;                // 0x01020304 as written by the compiler
+    uint64_t file_size;
+    ScenarioLayout layout;
+    ScenarioSection orders;
+    ScenarioSection products;
+    ScenarioSection bom;
+    ScenarioSection components;
+    ScenarioSection names;
+};
+
+static_assert(sizeof(ScenarioOrder) == 32, "ScenarioOrder is part of the file format");
+static_assert(sizeof(ScenarioProduct) == 24, "ScenarioProduct is part of the file format");
+static_assert(sizeof(ScenarioBomEntry) == 8, "ScenarioBomEntry is part of the file format");
+static_assert(sizeof(ScenarioComponent) == 16, "ScenarioComponent is part of the file format");
+static_assert(sizeof(ScenarioHeader) == 136, "ScenarioHeader is part of the file format");
+
+/****************************ScenarioImage Class Definition***************************/
+/**
+ * @class ScenarioImage
+ * @brief Read-only view of a compiled scenario file
+ *
+ * open() maps the file and checks the header and every index once; the
+ * accessors then point straight into the mapping, so loading a scenario
+ * costs no parsing and no allocation. load() rebuilds the text-input
+ * containers for code that needs them (the threaded simulation).
+ */
+class ScenarioImage {
+private:
+    std::unique_ptr<MappedFile> file;
+    const ScenarioHeader* header;
+
+    template <typename T>
+    const T* section(const ScenarioSection& s) const {
+        return reinterpret_cast<const T*>(file->view().data() + s.offset);
+    }
+    bool validate(const std::string& filename) const;
+
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    ScenarioImage() : header(nullptr) {}
+
+    static bool compile(const std::string& filename,
+                        const std::vector<Order>& orders,
+                        const std::map<std::string, Product>& products,
+                        const std::map<std::string, int>& inventory,
+                        const ScenarioLayout& layout);
+
+    bool open(const std::string& filename);
+    bool is_open() const { return header != nullptr; }
+    void load(std::vector<Order>& orders, std::map<std::string, Product>& products,
+              std::map<std::string, int>& inventory) const;
+
+    const ScenarioLayout& layout() const { return header->layout; }
+    size_t order_count() const { return (size_t)header->orders.count; }
+    size_t product_count() const { return (size_t)header->products.count; }
+    size_t component_count() const { return (size_t)header->components.count; }
+    const ScenarioOrder* orders() const { return section<ScenarioOrder>(header->orders); }
+    const ScenarioProduct* products() const { return section<ScenarioProduct>(header->products); }
+    const ScenarioBomEntry* bom() const { return section<ScenarioBomEntry>(header->bom); }
+    const ScenarioComponent* components() const { return section<ScenarioComponent>(header->components); }
+    std::string_view name(const ScenarioName& n) const {
+        return file->view().substr(header->names.offset + n.offset, n.length);
+    }
+};
+/*************************************************************************************/
+#endif /* SCENARIO_IMAGE_H */
@@ -0,0 +1,301 @@
+/**
+ * @file SequenceOptimizer.cpp
+ * @brief Metaheuristic sequence optimizer implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "SequenceOptimizer.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+/*************************************************************************************/
+
+namespace {
+// Cost of a canceled order, so the search never "wins" by starving orders of components
+const double CANCELED_ORDER_PENALTY = 10000.0;
+}
+
+/****************************SequenceOptimizer Methods*******************************/
+
+/**
+ * @brief Constructor for SequenceOptimizer
+ * @param sim Evaluator (must outlive the optimizer)
+ * @param config Search parameters
+ */
+SequenceOptimizer::SequenceOptimizer(const FastSimulator& sim, const OptimizerConfig& config)
+    : simulator(sim), cfg(config) {
+    cfg.iterations = std::max(1, cfg.iterations);
+    cfg.tabu_tenure = std::max(0, cfg.tabu_tenure);
+    cfg.tabu_neighbours = std::max(1, cfg.tabu_neighbours);
+}
+
+
+/**
+ * @brief Scalar cost of a run: the objective, then average lead time as tie-break
+ * @param kpis KPIs of the run
+ * @return Cost to minimize
+ */
+double SequenceOptimizer::cost(const FastSimResult& kpis) const {
+    double primary = (cfg.objective == OptimizerObjective::MAKESPAN)
+                         ? (double)kpis.makespan_minutes
+                         : (double)kpis.total_tardiness;
+    return primary + CANCELED_ORDER_PENALTY * kpis.canceled + 1e-3 * kpis.avg_lead_time;
+}
+
+
+/**
+ * @brief Number of worker threads to use
+ */
+int SequenceOptimizer::thread_count() const {
+    if (cfg.threads > 0) return cfg.threads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? (int)hw : 1;
+}
+
+
+/**
+ * @brief Apply a random neighbourhood move (swap, insertion or line change)
+ * @param plan Plan to modify in place
+ * @param rng Random generator of the calling chain
+ */
+void SequenceOptimizer::random_move(SequencePlan& plan, std::mt19937& rng) const {
+    int n = (int)plan.sequence.size();
+    if (n < 2) return;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    int kind = std::uniform_int_distribution<int>(0, 9)(rng);
+    int lines = simulator.config().num_lines;
+
+    if (kind < 2 && lines > 1) {            //Reassign one order to another line (or back to first free)
+        int position = plan.sequence[pick(rng)];
+        plan.lines[position] = std::uniform_int_distribution<int>(-1, lines - 1)(rng);
+        return;
+    }
+    int i = pick(rng), j = pick(rng);
+    while (j == i) j = pick(rng);
+    if (kind < 6) {
+        std::swap(plan.sequence[i], plan.sequence[j]);
+    } else {                                //Move one order to another position
+        int moved = plan.sequence[i];
+        plan.sequence.erase(plan.sequence.begin() + i);
+        plan.sequence.insert(plan.sequence.begin() + j, moved);
+    }
+}
+
+
+/**
+ * @brief One simulated annealing chain from the default plan
+ * @param seed Seed of the chain's random generator
+ * @return Best plan seen by the chain
+ */
+OptimizerResult SequenceOptimizer::run_annealing_chain(unsigned seed) const {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    SequencePlan current = simulator.default_plan();
+    FastSimResult initial = simulator.evaluate(current);
+    double current_cost = cost(initial);
+    OptimizerResult best;
+    best.plan = current; best.kpis = initial; best.cost = current_cost; best.evaluations = 1;
+
+    double t_start = std::max(1.0, 0.05 * current_cost);
+    double t_end = 0.01;
+    double cooling = std::pow(t_end / t_start, 1.0 / cfg.iterations);
+    double temperature = t_start;
+
+    for (int it = 0; it < cfg.iterations; ++it, temperature *= cooling) {
+        SequencePlan candidate = current;
+        random_move(candidate, rng);
+        FastSimResult kpis = simulator.evaluate(candidate);
+        best.evaluations++;
+        double candidate_cost = cost(kpis);
+        double delta = candidate_cost - current_cost;
+        if (delta <= 0 || unit(rng) < std::exp(-delta / temperature)) {
+            current.sequence.swap(candidate.sequence);
+            current.lines.swap(candidate.lines);
+            current_cost = candidate_cost;
+            if (current_cost < best.cost) {
+                best.plan = current; best.kpis = kpis; best.cost = current_cost;
+            }
+        }
+    }
+    return best;
+}
+
+
+/**
+ * @brief Run one annealing chain per thread and keep the best result
+ */
+OptimizerResult SequenceOptimizer::run_annealing() const {
+    int threads = thread_count();
+    std::vector<OptimizerResult> results(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([this, &results, t] { results[t] = run_annealing_chain(cfg.seed + 7919u * t); });
+    }
+    for (auto& worker : workers) worker.join();
+
+    OptimizerResult best = results[0];
+    long long evaluations = 0;
+    for (const auto& r : results) {
+        evaluations += r.evaluations;
+        if (r.cost < best.cost) best = r;
+    }
+    best.evaluations = evaluations;
+    return best;
+}
+
+
+/**
+ * @brief Tabu search; each iteration evaluates cfg.tabu_neighbours moves in parallel
+ * The worker threads live for the whole search: each round they take
+ * candidates from a shared counter (as ReplicationRunner does) until the
+ * neighbourhood is evaluated, then wait for the next round.
+ */
+OptimizerResult SequenceOptimizer::run_tabu() const {
+    struct Candidate {
+        SequencePlan plan;
+        std::vector<int> moved;     //Order positions touched by the move
+        FastSimResult kpis;
+        double cost;
+    };
+
+    std::mt19937 rng(cfg.seed);
+    int threads = std::min(thread_count(), cfg.tabu_neighbours);
+    SequencePlan current = simulator.default_plan();
+    OptimizerResult best;
+    best.plan = current; best.kpis = simulator.evaluate(current); best.cost = cost(best.kpis); best.evaluations = 1;
+    if (current.sequence.size() < 2) return best;
+
+    std::vector<int> tabu_until(simulator.order_count(), -1);
+    std::vector<Candidate> candidates(cfg.tabu_neighbours);
+
+    std::atomic<int> next_candidate(0);
+    auto evaluate_candidates = [this, &candidates, &next_candidate] {
+        for (int k = next_candidate++; k < (int)candidates.size(); k = next_candidate++) {
+            candidates[k].kpis = simulator.evaluate(candidates[k].plan);
+            candidates[k].cost = cost(candidates[k].kpis);
+        }
+    };
+    std::mutex round_mutex;
+    std::condition_variable round_cv;   //New round or shutdown (workers), round finished (search)
+    int round = 0;
+    int busy = 0;                       //Workers still evaluating the current round
+    bool done = false;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back([&] {
+            int seen = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lk(round_mutex);
+                    round_cv.wait(lk, [&] { return done || round != seen; });
+                    if (done) return;
+                    seen = round;
+                }
+                evaluate_candidates();
+                std::lock_guard<std::mutex> lk(round_mutex);
+                if (--busy == 0) round_cv.notify_all();
+            }
+        });
+    }
+
+    for (int it = 0; it < cfg.iterations; ++it) {
+        for (auto& c : candidates) {            //Generate moves serially so the run is reproducible
+            c.plan = current;
+            random_move(c.plan, rng);
+            c.moved.clear();
+            for (size_t k = 0; k < c.plan.sequence.size(); ++k) {
+                if (c.plan.sequence[k] != current.sequence[k]) c.moved.push_back(c.plan.sequence[k]);
+            }
+            for (size_t k = 0; k < c.plan.lines.size(); ++k) {
+                if (c.plan.lines[k] != current.lines[k]) c.moved.push_back((int)k);
+            }
+        }
+
+        next_candidate = 0;
+        {
+            std::lock_guard<std::mutex> lk(round_mutex);
+            busy = (int)workers.size();
+            round++;
+        }
+        round_cv.notify_all();
+        evaluate_candidates();                  //The search thread takes its share too
+        {
+            std::unique_lock<std::mutex> lk(round_mutex);
+            round_cv.wait(lk, [&] { return busy == 0; });
+        }
+        best.evaluations += (long long)candidates.size();
+
+        int chosen = -1;
+        for (int k = 0; k < (int)candidates.size(); ++k) {
+            bool tabu = !candidates[k].moved.empty();
+            for (int position : candidates[k].moved) { if (tabu_until[position] < it) { tabu = false; break; } }
+            bool aspiration = candidates[k].cost < best.cost;
+            if (tabu && !aspiration) continue;
+            if (chosen < 0 || candidates[k].cost < candidates[chosen].cost) chosen = k;
+        }
+        if (chosen < 0) continue;
+
+        current = candidates[chosen].plan;
+        for (int position : candidates[chosen].moved) tabu_until[position] = it + cfg.tabu_tenure;
+        if (candidates[chosen].cost < best.cost) {
+            best.plan = current; best.kpis = candidates[chosen].kpis; best.cost = candidates[chosen].cost;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(round_mutex);
+        done = true;
+    }
+    round_cv.notify_all();
+    for (auto& worker : workers) worker.join();
+    return best;
+}
+
+
+/**
+ * @brief Run the configured metaheuristic
+ * @return Best plan found
+ */
+OptimizerResult SequenceOptimizer::run() const {
+    return (cfg.method == OptimizerMethod::TABU_SEARCH) ? run_tabu() : run_annealing();
+}
+
+
+const char* to_string(OptimizerMethod method) {
+    return (method == OptimizerMethod::TABU_SEARCH) ? "TABU_SEARCH" : "SIMULATED_ANNEALING";
+}
+
+const char* to_string(OptimizerObjective objective) {
+    return (objective == OptimizerObjective::MAKESPAN) ? "MAKESPAN" : "TOTAL_TARDINESS";
+}
+
+/**
+ * @brief Parse an optimizer method name (sa, tabu)
+ * @return false if the name is unknown
+ */
+bool parse_optimizer_method(const std::string& name, OptimizerMethod& method) {
+    if (name == "sa") method = OptimizerMethod::SIMULATED_ANNEALING;
+    else if (name == "tabu") method = OptimizerMethod::TABU_SEARCH;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Parse an optimizer objective name (tardiness, makespan)
+ * @return false if the name is unknown
+ */
+bool parse_optimizer_objective(const std::string& name, OptimizerObjective& objective) {
+    if (name == "tardiness") objective = OptimizerObjective::TOTAL_TARDINESS;
+    else if (name == "makespan") objective = OptimizerObjective::MAKESPAN;
+    else return false;
+    return true;
+}
+/*************************************************************************************/
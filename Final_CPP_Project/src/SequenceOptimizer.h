@@ -0,0 +1,92 @@
+/**
+ * @file SequenceOptimizer.h
+ * @brief Simulated annealing / tabu search over release and line sequences
+ */
+
+#ifndef SEQUENCE_OPTIMIZER_H
+#define SEQUENCE_OPTIMIZER_H
+
+/******************************Project Headers*****************************************/
+#include "FastSimulator.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <random>
+#include <string>
+/*************************************************************************************/
+
+/**
+ * @enum OptimizerMethod
+ * @brief Metaheuristic used to search the sequence space
+ */
+enum class OptimizerMethod {
+    SIMULATED_ANNEALING,
+    TABU_SEARCH
+};
+
+/**
+ * @enum OptimizerObjective
+ * @brief KPI minimized by the optimizer
+ */
+enum class OptimizerObjective {
+    TOTAL_TARDINESS,
+    MAKESPAN
+};
+
+/**
+ * @struct OptimizerConfig
+ * @brief Search parameters
+ */
+struct OptimizerConfig {
+    OptimizerMethod method = OptimizerMethod::SIMULATED_ANNEALING;
+    OptimizerObjective objective = OptimizerObjective::TOTAL_TARDINESS;
+    int iterations = 20000;     // Per annealing chain, or tabu iterations
+    int threads = 0;            // 0 = all hardware threads
+    unsigned seed = 1;
+    int tabu_tenure = 10;       // Iterations a moved order stays tabu
+    int tabu_neighbours = 64;   // Candidate moves evaluated per tabu iteration
+};
+
+/**
+ * @struct OptimizerResult
+ * @brief Best plan found and its KPIs
+ */
+struct OptimizerResult {
+    SequencePlan plan;
+    FastSimResult kpis;
+    double cost = 0.0;
+    long long evaluations = 0;
+};
+
+/****************************SequenceOptimizer Class Definition***********************/
+/**
+ * @class SequenceOptimizer
+ * @brief Searches staging sequences and line assignments using FastSimulator
+ *
+ * Simulated annealing runs one independent chain per thread and keeps the
+ * best; tabu search evaluates each iteration's neighbourhood across threads.
+ */
+class SequenceOptimizer {
+private:
+    const FastSimulator& simulator;
+    OptimizerConfig cfg;
+
+    int thread_count() const;
+    void random_move(SequencePlan& plan, std::mt19937& rng) const;
+    OptimizerResult run_annealing_chain(unsigned seed) const;
+    OptimizerResult run_annealing() const;
+    OptimizerResult run_tabu() const;
+
+public:
+    SequenceOptimizer(const FastSimulator& sim, const OptimizerConfig& config);
+
+    OptimizerResult run() const;
+    double cost(const FastSimResult& kpis) const;
+};
+
+const char* to_string(OptimizerMethod method);
+const char* to_string(OptimizerObjective objective);
+bool parse_optimizer_method(const std::string& name, OptimizerMethod& method);
+bool parse_optimizer_objective(const std::string& name, OptimizerObjective& objective);
+/*************************************************************************************/
+#endif /* SEQUENCE_OPTIMIZER_H */
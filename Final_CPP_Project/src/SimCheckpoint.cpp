@@ -0,0 +1,225 @@
+/**
+ * @file SimCheckpoint.cpp
+ * @brief Checkpoint writer and reader implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "SimCheckpoint.h"
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstring>
+#include <iostream>
+#include <vector>
+/*************************************************************************************/
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'F', 'A', 'S', 'C', 'H', 'K', 'P', 'T'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+size_t align8(size_t offset) { return (offset + 7) & ~(size_t)7; }
+
+/**
+ * @brief Write count records, then zero padding up to the next 8-byte boundary
+ */
+void put_records(BufferedWriter& out, const void* data, size_t bytes) {
+    static const char zeros[8] = {0};
+    if (bytes > 0) out.write(static_cast<const char*>(data), bytes);
+    out.write(zeros, align8(bytes) - bytes);
+}
+
+/**
+ * @brief Copy the next section out of the file and advance past its padding
+ * @return false if the section runs past the end of the file
+ */
+bool take_records(std::string_view bytes, size_t& offset, void* data, size_t size) {
+    if (offset > bytes.size() || size > bytes.size() - offset) return false;
+    if (size > 0) std::memcpy(data, bytes.data() + offset, size);
+    offset = align8(offset + size);
+    return true;
+}
+
+/**
+ * @brief Size of a checkpoint file with the given section counts (the layout in SimCheckpoint.h)
+ */
+uint64_t checkpoint_size(uint64_t components, uint64_t agvs, uint64_t lines, uint64_t orders,
+                         uint64_t released, uint64_t in_system) {
+    return align8(sizeof(CheckpointHeader))
+         + align8(components * sizeof(int32_t))
+         + align8(agvs * sizeof(int32_t))
+         + 2 * align8(lines * sizeof(int32_t))
+         + align8(orders)
+         + released * sizeof(CheckpointEntry)
+         + in_system * 2 * sizeof(int32_t);
+}
+
+} // namespace
+
+/****************************SimCheckpoint Methods************************************/
+
+/**
+ * @brief Write a run state to a checkpoint file
+ * @param filename Output path
+ * @param state Run state (e.g. after FastSimulator::advance stopped)
+ * @return true if the file was written
+ */
+bool SimCheckpoint::save(const std::string& filename, const FastSimState& state) {
+    const std::vector<DispatchEntry<int>>& released = state.released.entries();
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.order_count = state.order_states.size();
+    header.component_count = (uint32_t)state.inventory.size();
+    header.num_agvs = (int32_t)state.agv_free.size();
+    header.num_lines = (int32_t)state.line_free.size();
+    header.clock = state.clock;
+    header.first_release = state.first_release;
+    header.last_completion = state.last_completion;
+    header.agv_busy = state.agv_busy;
+    header.station_busy = state.station_busy;
+    header.total_lead = state.total_lead;
+    header.total_tardiness = state.result.total_tardiness;
+    header.max_tardiness = state.result.max_tardiness;
+    header.late_orders = state.result.late_orders;
+    header.completed = state.result.completed;
+    header.canceled = state.result.canceled;
+    header.next_release = state.next_release;
+    header.next_sequence = state.released.sequence();
+    header.released_count = released.size();
+    state.rng.save(header.rng_state);
+    header.stochastic = state.stochastic ? 1 : 0;
+    std::strncpy(header.rule, state.rule.c_str(), sizeof(header.rule) - 1);
+    header.keyed_at = state.released.keyed_time();
+    header.stale_pops = state.released.pops_since_rekey();
+    header.in_system_count = state.in_system.size();
+    header.file_size = checkpoint_size(state.inventory.size(), state.agv_free.size(), state.line_free.size(),
+                                       state.order_states.size(), released.size(), state.in_system.size());
+
+    std::vector<CheckpointEntry> entries;
+    entries.reserve(released.size());
+    for (const DispatchEntry<int>& entry : released) {
+        entries.push_back(CheckpointEntry{entry.key, entry.release_time_minutes, entry.item, entry.sequence});
+    }
+    std::vector<int32_t> in_system;
+    in_system.reserve(2 * state.in_system.size());
+    for (const auto& entry : state.in_system) {
+        in_system.push_back(entry.first);
+        in_system.push_back(entry.second);
+    }
+
+    BufferedWriter out(filename, 1 << 20);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+    static_assert(sizeof(OrderState) == 1, "order states are stored one byte each");
+    put_records(out, &header, sizeof(header));
+    put_records(out, state.inventory.data(), state.inventory.size() * sizeof(int32_t));
+    put_records(out, state.agv_free.data(), state.agv_free.size() * sizeof(int32_t));
+    put_records(out, state.line_free.data(), state.line_free.size() * sizeof(int32_t));
+    put_records(out, state.line_product.data(), state.line_product.size() * sizeof(int32_t));
+    put_records(out, state.order_states.data(), state.order_states.size());
+    put_records(out, entries.data(), entries.size() * sizeof(CheckpointEntry));
+    put_records(out, in_system.data(), in_system.size() * sizeof(int32_t));
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Read a checkpoint file back into a run state
+ * @param filename Path of the checkpoint
+ * @param state Replaced by the saved state
+ * @return true if the checkpoint is valid
+ */
+bool SimCheckpoint::load(const std::string& filename, FastSimState& state) {
+    MappedFile file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return false;
+    }
+    std::string_view bytes = file.view();
+    CheckpointHeader header;
+    if (bytes.size() < sizeof(header) || std::memcmp(bytes.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        std::cerr << "Error: " << filename << " is not a checkpoint" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.byte_order != BYTE_ORDER_MARK || header.version != VERSION) {
+        std::cerr << "Error: " << filename << " is a version " << header.version << " or foreign byte order "
+                  << "checkpoint (expected version " << VERSION << ")" << std::endl;
+        return false;
+    }
+    // Every count must fit in the file before anything is allocated from it; bounding
+    // each count by the file size first keeps the expected size from overflowing
+    if (header.file_size != bytes.size() || header.num_agvs < 0 || header.num_lines < 0 ||
+        header.order_count > bytes.size() || header.released_count > bytes.size() / sizeof(CheckpointEntry) ||
+        header.in_system_count > bytes.size() / (2 * sizeof(int32_t)) ||
+        checkpoint_size(header.component_count, (uint64_t)header.num_agvs, (uint64_t)header.num_lines, header.order_count,
+                        header.released_count, header.in_system_count) != header.file_size) {
+        std::cerr << "Error: " << filename << " is a damaged checkpoint" << std::endl;
+        return false;
+    }
+
+    FastSimState loaded;
+    loaded.clock = header.clock;
+    loaded.first_release = header.first_release;
+    loaded.last_completion = header.last_completion;
+    loaded.agv_busy = header.agv_busy;
+    loaded.station_busy = header.station_busy;
+    loaded.total_lead = header.total_lead;
+    loaded.result.total_tardiness = header.total_tardiness;
+    loaded.result.max_tardiness = header.max_tardiness;
+    loaded.result.late_orders = header.late_orders;
+    loaded.result.completed = header.completed;
+    loaded.result.canceled = header.canceled;
+    loaded.next_release = header.next_release;
+    loaded.rule = std::string(header.rule, strnlen(header.rule, sizeof(header.rule)));
+    loaded.stochastic = header.stochastic != 0;
+    loaded.rng.restore(header.rng_state);
+    loaded.inventory.resize(header.component_count);
+    loaded.agv_free.resize(header.num_agvs);
+    loaded.line_free.resize(header.num_lines);
+    loaded.line_product.resize(header.num_lines);
+    loaded.order_states.resize(header.order_count);
+    std::vector<CheckpointEntry> entries(header.released_count);
+    std::vector<int32_t> in_system(2 * header.in_system_count);
+
+    size_t offset = align8(sizeof(header));
+    bool valid = take_records(bytes, offset, loaded.inventory.data(), loaded.inventory.size() * sizeof(int32_t)) &&
+                 take_records(bytes, offset, loaded.agv_free.data(), loaded.agv_free.size() * sizeof(int32_t)) &&
+                 take_records(bytes, offset, loaded.line_free.data(), loaded.line_free.size() * sizeof(int32_t)) &&
+                 take_records(bytes, offset, loaded.line_product.data(), loaded.line_product.size() * sizeof(int32_t)) &&
+                 take_records(bytes, offset, loaded.order_states.data(), loaded.order_states.size()) &&
+                 take_records(bytes, offset, entries.data(), entries.size() * sizeof(CheckpointEntry)) &&
+                 take_records(bytes, offset, in_system.data(), in_system.size() * sizeof(int32_t));
+    for (size_t i = 0; valid && i < loaded.order_states.size(); ++i) {
+        valid = (uint8_t)loaded.order_states[i] <= (uint8_t)OrderState::CANCELED;
+    }
+    if (!valid) {
+        std::cerr << "Error: " << filename << " is a damaged checkpoint" << std::endl;
+        return false;
+    }
+
+    std::vector<DispatchEntry<int>> released;
+    released.reserve(entries.size());
+    for (const CheckpointEntry& entry : entries) {
+        released.push_back(DispatchEntry<int>{entry.key, entry.release_time_minutes, entry.sequence, entry.position});
+    }
+    for (size_t i = 0; i < in_system.size(); i += 2) {
+        loaded.in_system.emplace_back(in_system[i], in_system[i + 1]);
+    }
+    loaded.released.assign(std::move(released), header.next_sequence, header.keyed_at, header.stale_pops);
+    state = std::move(loaded);
+    return true;
+}
+/*************************************************************************************/
@@ -0,0 +1,83 @@
+/**
+ * @file SimCheckpoint.h
+ * @brief Compact binary snapshot of a fast simulation run (save, restore, fork)
+ */
+
+#ifndef SIM_CHECKPOINT_H
+#define SIM_CHECKPOINT_H
+
+/******************************Project Headers*****************************************/
+#include "FastSimulator.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstdint>
+#include <string>
+/*************************************************************************************/
+
+/*
+ * File layout (version 3, native little-endian, every section 8-byte aligned):
+ *   CheckpointHeader | int32 inventory[components] | int32 agv_free[agvs] |
+ *   int32 line_free[lines] | int32 line_product[lines] | uint8 order_state[orders] |
+ *   CheckpointEntry released[released_count] | int32 in_system[2 * in_system_count]
+ * A 10^6-order checkpoint is about 1 MB plus 24 bytes per queued order.
+ */
+
+struct CheckpointEntry {
+    double key;
+    int32_t release_time_minutes;
+    int32_t position;                   // Order position in the scenario
+    uint64_t sequence;
+};
+
+struct CheckpointHeader {
+    char magic[8];                      // "FASCHKPT"
+    uint32_t version;
+    uint32_t byte_order;                // 0x01020304 as written
+    uint64_t file_size;
+    uint64_t order_count;
+    uint32_t component_count;
+    int32_t num_agvs;
+    int32_t num_lines;
+    int32_t clock;                      // Staging clock in minutes
+    int32_t first_release;
+    int32_t last_completion;
+    int64_t agv_busy;
+    int64_t station_busy;
+    int64_t total_lead;
+    int64_t total_tardiness;
+    int32_t max_tardiness;
+    int32_t late_orders;
+    int32_t completed;
+    int32_t canceled;
+    uint64_t next_release;
+    uint64_t next_sequence;
+    uint64_t released_count;
+    uint64_t rng_state[4];
+    uint32_t stochastic;
+    char rule[20];                      // Dispatch rule name, zero-padded
+    int32_t keyed_at;                   // Re-key state of the released queue
+    uint32_t stale_pops;
+    uint64_t in_system_count;           // Orders holding a CONWIP slot or kanban card
+};
+
+static_assert(sizeof(CheckpointEntry) == 24, "CheckpointEntry is part of the file format");
+static_assert(sizeof(CheckpointHeader) == 200, "CheckpointHeader is part of the file format");
+
+/****************************SimCheckpoint Class Definition***************************/
+/**
+ * @class SimCheckpoint
+ * @brief Writes and reads FastSimState snapshots
+ *
+ * A checkpoint holds the run state only; resuming needs the same scenario
+ * and cell, which FastSimulator::check_state() verifies after load().
+ */
+class SimCheckpoint {
+public:
+    static constexpr uint32_t VERSION = 3;
+
+    static bool save(const std::string& filename, const FastSimState& state);
+    static bool load(const std::string& filename, FastSimState& state);
+};
+/*************************************************************************************/
+#endif /* SIM_CHECKPOINT_H */
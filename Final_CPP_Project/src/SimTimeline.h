@@ -0,0 +1,69 @@
+/**
+ * @file SimTimeline.h
+ * @brief Wall-clock spans of every AGV state and assembly-line operation, for trace viewers
+ */
+
+#ifndef SIM_TIMELINE_H
+#define SIM_TIMELINE_H
+
+/*****************************Standard Libraries***************************************/
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @struct TimelineSpan
+ * @brief One span on an AGV or line track (microseconds since the simulation started)
+ */
+struct TimelineSpan {
+    const char* name = "";          // AGV state, "setup" or "assembly"
+    int64_t start_us = 0;
+    int64_t end_us = 0;
+    int order_id = -1;
+    std::string load;               // Component or product carried / assembled
+    bool finished_product = false;  // AGV span of a finished-product return trip
+    int virtual_start = -1;         // Line spans: line virtual minutes
+    int virtual_end = -1;
+};
+
+/****************************SimTimeline Class Definition*****************************/
+/**
+ * @class SimTimeline
+ * @brief Per-track span lists for a Chrome/Perfetto trace export
+ *
+ * Tracks are sized by reset() before any simulation thread starts. Each
+ * track is appended to only by the thread that owns it (one AGV thread or
+ * one line thread), so recording takes no lock; tracks are read after
+ * every thread has stopped.
+ */
+class SimTimeline {
+private:
+    std::chrono::steady_clock::time_point origin;
+    std::vector<std::vector<TimelineSpan>> agv_tracks;     // By AGV position in the fleet
+    std::vector<std::vector<TimelineSpan>> line_tracks;    // By line index
+
+public:
+    void reset(int agv_count, int line_count) {
+        origin = std::chrono::steady_clock::now();
+        agv_tracks.assign(agv_count, std::vector<TimelineSpan>());
+        line_tracks.assign(line_count, std::vector<TimelineSpan>());
+    }
+
+    int64_t now_us() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    void add_agv_span(int track, TimelineSpan span) {
+        if (track >= 0 && track < (int)agv_tracks.size()) agv_tracks[track].push_back(std::move(span));
+    }
+    void add_line_span(int line, TimelineSpan span) {
+        if (line >= 0 && line < (int)line_tracks.size()) line_tracks[line].push_back(std::move(span));
+    }
+
+    const std::vector<std::vector<TimelineSpan>>& agvs() const { return agv_tracks; }
+    const std::vector<std::vector<TimelineSpan>>& lines() const { return line_tracks; }
+};
+/*************************************************************************************/
+#endif /* SIM_TIMELINE_H */
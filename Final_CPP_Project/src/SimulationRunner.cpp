@@ -0,0 +1,153 @@
+/**
+ * @file SimulationRunner.cpp
+ * @brief Threaded scenario run implementation
+ */
+
+/******************************Project Headers*****************************************/
+#include "SimulationRunner.h"
+#include "AGV.h"
+#include "AssemblyStation.h"
+#include "ControlCenter.h"
+#include "MetricsServer.h"
+#include "ScenarioImage.h"
+#include "Warehouse.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <iostream>
+#include <memory>
+/*************************************************************************************/
+
+/****************************SimulationRunner Methods*********************************/
+
+/**
+ * @brief Load the inputs, run the cell to completion and collect the results
+ * @param result Filled with the KPIs and per-order results
+ * @return false if an input could not be loaded (the error is printed)
+ */
+bool SimulationRunner::run(SimulationResult& result) const {
+    if (!cfg.scenario_file.empty() && !cfg.stream_file.empty()) {
+        std::cerr << "Error: A scenario image and an order stream cannot be combined" << std::endl;
+        return false;
+    }
+    if (cfg.conwip_cap < 0) {
+        std::cerr << "Error: CONWIP cap must be 0 (off) or more, got " << cfg.conwip_cap << std::endl;
+        return false;
+    }
+    for (const auto& cards : cfg.kanban_cards) {
+        if (cards.second < 1) {
+            // A family without cards could never release an order, and the run would never finish
+            std::cerr << "Error: Product family " << cards.first << " needs at least 1 kanban card" << std::endl;
+            return false;
+        }
+    }
+    ScenarioImage scenario;
+    if (!cfg.scenario_file.empty() && !scenario.open(cfg.scenario_file)) {
+        return false;
+    }
+    int num_agvs = scenario.is_open() ? scenario.layout().num_agvs : cfg.num_agvs;
+    int num_lines = scenario.is_open() ? scenario.layout().num_lines : cfg.num_lines;
+
+    // Initialize core components
+    Warehouse warehouse;
+    std::vector<AGV*> agv_fleet;
+    ControlCenter control_center(cfg.log_file);
+    control_center.set_report_files(cfg.kpi_report_file, cfg.kpi_json_file, cfg.order_results_file);
+    if (!cfg.trace_file.empty() && !control_center.enable_event_trace(cfg.trace_file)) {
+        return false;
+    }
+    if (!cfg.chrome_trace_file.empty()) {
+        control_center.enable_timeline(cfg.chrome_trace_file);
+    }
+    control_center.set_log_level(cfg.log_level);
+    AssemblyStation assembly_station(&warehouse, &agv_fleet);
+    assembly_station.set_station_count(num_lines);
+
+    // Load inputs
+    if (cfg.verbose) std::cout << "Loading input files...\n";
+    if (scenario.is_open()) {
+        if (!control_center.load_scenario(scenario, &warehouse)) {
+            std::cerr << "Error: Failed to load scenario: " << cfg.scenario_file << std::endl;
+            return false;
+        }
+        if (cfg.verbose) std::cout << "   Loaded orders, BOM and inventory from " << cfg.scenario_file << std::endl;
+    } else {
+        if (!cfg.stream_file.empty()) {
+            if (!control_center.stream_orders(cfg.stream_file, cfg.follow_stream, cfg.stream_capacity)) {
+                std::cerr << "Error: Failed to open order stream: " << cfg.stream_file << std::endl;
+                return false;
+            }
+            if (cfg.verbose) {
+                std::cout << "   Streaming orders from " << cfg.stream_file << (cfg.follow_stream ? " (follow)" : "") << std::endl;
+            }
+        } else if (!control_center.load_orders(cfg.orders_file)) {
+            std::cerr << "Error: Failed to load orders file: " << cfg.orders_file << std::endl;
+            return false;
+        } else if (cfg.verbose) {
+            std::cout << "   Loaded orders from " << cfg.orders_file << std::endl;
+        }
+
+        if (!control_center.load_bom(cfg.bom_file)) {
+            std::cerr << "Error: Failed to load BOM file: " << cfg.bom_file << std::endl;
+            return false;
+        }
+        if (cfg.verbose) std::cout << "   Loaded BOM from " << cfg.bom_file << std::endl;
+
+        if (!control_center.load_warehouse(cfg.warehouse_file, &warehouse)) {
+            std::cerr << "Error: Failed to load warehouse file: " << cfg.warehouse_file << std::endl;
+            return false;
+        }
+        if (cfg.verbose) std::cout << "   Loaded warehouse inventory from " << cfg.warehouse_file << std::endl;
+    }
+
+    // Create AGV fleet (threads will be started by ControlCenter)
+    if (cfg.verbose) std::cout << "\nInitializing AGV fleet (" << num_agvs << " AGVs)...\n";
+    std::vector<std::unique_ptr<AGV>> agvs;
+    for (int i = 1; i <= num_agvs; i++) {
+        agvs.emplace_back(new AGV(i));
+        agv_fleet.push_back(agvs.back().get());
+        if (cfg.verbose) std::cout << "   AGV" << i << " initialized\n";
+    }
+
+    control_center.set_scheduling_policy(cfg.policy);
+    control_center.set_conwip(cfg.conwip_cap);
+    for (const auto& cards : cfg.kanban_cards) {
+        control_center.set_kanban_cards(cards.first, cards.second);
+    }
+
+    // Start simulation (ControlCenter wires station and starts all threads)
+    if (cfg.verbose) {
+        std::cout << "\nStarting simulation...\n";
+        std::cout << "========================================\n";
+    }
+    control_center.start_simulation(&assembly_station, &agv_fleet);
+
+    MetricsServer metrics_server(&control_center, &warehouse, &agv_fleet);
+    if (!cfg.metrics_socket.empty()) {
+        if (metrics_server.start(cfg.metrics_socket)) {
+            if (cfg.verbose) std::cout << "Serving metrics on unix socket " << cfg.metrics_socket << "\n";
+        } else {
+            std::cerr << "Error: Metrics not served on " << cfg.metrics_socket << "; the run continues without them" << std::endl;
+        }
+    }
+
+    // Wait until all released orders complete instead of sleeping (and the order stream ends)
+    control_center.wait_until_all_orders_complete();
+
+    // Stop everything via ControlCenter (it will stop station and AGVs)
+    if (cfg.verbose) std::cout << "\nStopping simulation...\n";
+    control_center.stop_simulation();
+    metrics_server.stop();
+
+    result.kpis = control_center.get_kpis();
+    result.orders = control_center.get_order_records();
+    result.completed = result.canceled = 0;
+    result.subassemblies_completed = result.subassemblies_canceled = 0;
+    for (const OrderRecord& record : result.orders) {
+        bool subassembly = record.parent_order_id >= 0;  //Internal work, counted apart from customer orders
+        if (record.status == "completed") (subassembly ? result.subassemblies_completed : result.completed)++;
+        else if (record.status == "canceled") (subassembly ? result.subassemblies_canceled : result.canceled)++;
+    }
+    return true;
+}
+/*************************************************************************************/
@@ -0,0 +1,89 @@
+/**
+ * @file SimulationRunner.h
+ * @brief Run-a-scenario API over the threaded simulation (loads inputs, runs the cell, returns KPIs)
+ */
+
+#ifndef SIMULATION_RUNNER_H
+#define SIMULATION_RUNNER_H
+
+/******************************Project Headers*****************************************/
+#include "DispatchRule.h"
+#include "KpiReport.h"
+#include "LogLevel.h"
+/**************************************************************************************/
+
+/*****************************Standard Libraries***************************************/
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+/*************************************************************************************/
+
+/**
+ * @struct SimulationConfig
+ * @brief Inputs, cell and outputs of one threaded run; "" disables a file
+ */
+struct SimulationConfig {
+    // Inputs: a compiled scenario (with its layout), or the text files with orders optionally streamed
+    std::string orders_file = "input/orders.txt";
+    std::string bom_file = "input/bom.txt";
+    std::string warehouse_file = "input/warehouse.txt";
+    std::string scenario_file;
+    std::string stream_file;
+    bool follow_stream = false;
+    size_t stream_capacity = 10000;     // Max streamed orders, sub-assemblies included
+
+    // Cell and release control (a scenario's layout replaces the fleet and line counts)
+    int num_agvs = 10;
+    int num_lines = 1;
+    SchedulingPolicy policy = SchedulingPolicy::PRIORITY;
+    int conwip_cap = 0;                 // 0 = release on timestamp only
+    std::map<std::string, int> kanban_cards;    // Product family -> cards (none = no kanban limit)
+
+    // Outputs
+    LogLevel log_level = LogLevel::DIAG;
+    std::string log_file = "output/sim_log.txt";
+    std::string kpi_report_file = "output/kpi_report.txt";
+    std::string kpi_json_file = "output/kpi_report.json";
+    std::string order_results_file = "output/order_results.csv";
+    std::string trace_file;             // Binary event trace instead of the text log
+    std::string chrome_trace_file;      // Perfetto/Chrome timeline
+    std::string metrics_socket;         // Live Prometheus metrics
+    bool verbose = false;               // Print loading and start-up progress
+};
+
+/**
+ * @struct SimulationResult
+ * @brief KPIs and per-order results of a finished run
+ */
+struct SimulationResult {
+    KpiReport kpis;
+    std::vector<OrderRecord> orders;    // Customer and sub-assembly orders
+    int completed = 0;                  // Customer orders only
+    int canceled = 0;
+    int subassemblies_completed = 0;    // Generated sub-assembly orders
+    int subassemblies_canceled = 0;
+};
+
+/****************************SimulationRunner Class Definition************************/
+/**
+ * @class SimulationRunner
+ * @brief Wires Warehouse, AGV fleet, AssemblyStation and ControlCenter for one run
+ *
+ * run() blocks until every order has completed or been canceled (and an
+ * order stream has ended), then returns the KPIs in memory; report files
+ * are written only where the config names them. Runs take wall-clock time
+ * (100 ms per admitted order), so the fast model remains the tool for
+ * sweeps and optimization.
+ */
+class SimulationRunner {
+private:
+    SimulationConfig cfg;
+
+public:
+    explicit SimulationRunner(const SimulationConfig& config) : cfg(config) {}
+
+    bool run(SimulationResult& result) const;
+};
+/*************************************************************************************/
+#endif /* SIMULATION_RUNNER_H */
@@ -0,0 +1,77 @@
+/**
+ * @file TextScan.h
+ * @brief Allocation-free line, token and number scanning over a string_view
+ */
+
+#ifndef TEXT_SCAN_H
+#define TEXT_SCAN_H
+
+/*****************************Standard Libraries***************************************/
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+/*************************************************************************************/
+
+/****************************LineReader Class Definition******************************/
+/**
+ * @class LineReader
+ * @brief Yields the lines of a text (LF or CRLF) with their 1-based numbers
+ */
+class LineReader {
+private:
+    std::string_view rest;
+    int number;
+
+public:
+    explicit LineReader(std::string_view text) : rest(text), number(0) {}
+
+    bool next(std::string_view& line) {
+        if (rest.empty()) return false;
+        size_t end = rest.find('\n');
+        line = rest.substr(0, end);
+        rest = (end == std::string_view::npos) ? std::string_view() : rest.substr(end + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        ++number;
+        return true;
+    }
+    int line_number() const { return number; }
+};
+/*************************************************************************************/
+
+/**
+ * @brief Split a line on blanks into at most max_tokens views
+ * @return Number of tokens on the line (may exceed max_tokens; extra ones are not stored)
+ */
+inline size_t split_tokens(std::string_view line, std::string_view* tokens, size_t max_tokens) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (true) {
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+        if (pos >= line.size()) break;
+        size_t start = pos;
+        while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t') ++pos;
+        if (count < max_tokens) tokens[count] = line.substr(start, pos - start);
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Parse a whole token as an integer (no sign prefix '+', no trailing characters)
+ */
+template <typename T>
+inline bool parse_number(std::string_view token, T& value) {
+    const char* end = token.data() + token.size();
+    auto result = std::from_chars(token.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * @brief True for blank lines and '#' comments
+ */
+inline bool is_comment_or_blank(std::string_view line) {
+    size_t first = line.find_first_not_of(" \t");
+    return first == std::string_view::npos || line[first] == '#';
+}
+
+#endif /* TEXT_SCAN_H */
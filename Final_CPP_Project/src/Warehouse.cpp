@@ -17,7 +17,8 @@
 /**
  * @brief Constructor for Warehouse
  */
-Warehouse::Warehouse() {
+Warehouse::Warehouse()
+    : component_version(0), published_count(0), unpublished_logged(false) {
     // Initialize empty warehouse
 }
 
@@ -32,8 +33,8 @@ bool Warehouse::has_components(const std::map<std::string, int>& required) {
     std::lock_guard<std::mutex> lock(inventory_mutex);  // Lock inventory for check <----RC------------------
     
     for (const auto& req : required) {
-        auto it = components.find(req.first);
-        if (it == components.end() || it->second < req.second) { // Not enough quantity
+        auto it = component_index.find(req.first);
+        if (it == component_index.end() || stock[it->second] < req.second) { // Not enough quantity
             return false;
         }
     }
@@ -44,9 +45,10 @@ bool Warehouse::has_components(const std::map<std::string, int>& required) {
 /**
  * @brief Reserve required components atomically
  * @param required Map of component_id to required quantity
+ * @param shortage Set to the first short component (-1 if unknown) and the missing units on failure
  * @return true if reservation is successful, false otherwise
  */
-bool Warehouse::reserve_components(const std::map<std::string, int>& required) {
+bool Warehouse::reserve_components(const std::map<std::string, int>& required, BomLine* shortage) {
     std::lock_guard<std::mutex> lock(inventory_mutex);  // Lock inventory for atomic check and reserve //<-----------------
    
     // Check and deduction happen atomically
@@ -54,23 +56,47 @@ bool Warehouse::reserve_components(const std::map<std::string, int>& required) {
     // Check availability first
     //If any component is missing → NO reservation occurs
     for (const auto& req : required) {
-        auto it = components.find(req.first);
-        int available = (it != components.end()) ? it->second : 0;
+        auto it = component_index.find(req.first);
+        int available = (it != component_index.end()) ? stock[it->second] : 0;
         if (available < req.second) {
-            log_component_availability(req.first, req.second, available);
+            if (shortage) *shortage = BomLine{it != component_index.end() ? it->second : -1, req.second - available};
             return false;
         }
     }
     
     // Reserve components
     for (const auto& req : required) {
-        components[req.first] -= req.second; // Deduct reserved quantity
+        int index = register_component_locked(req.first);
+        stock[index] -= req.second; // Deduct reserved quantity
+        publish_locked(index);
     }
     
     return true;
 }
 
 
+/**
+ * @brief Reserve a compiled BOM atomically (index-based, no map lookups)
+ * @param required Flat BOM produced by compile_bom
+ * @param shortage Set to the first short component and the missing units on failure
+ * @return true if reservation is successful, false otherwise
+ */
+bool Warehouse::reserve_components(const std::vector<BomLine>& required, BomLine* shortage) {
+    std::lock_guard<std::mutex> lock(inventory_mutex);  // Lock inventory for atomic check and reserve //<-----------------
+    for (const auto& line : required) {
+        if (stock[line.component_index] < line.quantity) {
+            if (shortage) *shortage = BomLine{line.component_index, line.quantity - stock[line.component_index]};
+            return false;
+        }
+    }
+    for (const auto& line : required) {
+        stock[line.component_index] -= line.quantity;
+        publish_locked(line.component_index);
+    }
+    return true;
+}
+
+
 /**
  * @brief Add components to the warehouse inventory
  * @param component_id The ID of the component
@@ -78,7 +104,10 @@ bool Warehouse::reserve_components(const std::map<std::string, int>& required) {
  */
 void Warehouse::add_component(const std::string& component_id, int quantity) {
     std::lock_guard<std::mutex> lock(inventory_mutex); //(Reservation) Lock inventory for update <----------------------------
-    components[component_id] += quantity;
+    int index = register_component_locked(component_id);
+    stock[index] += quantity;
+    publish_locked(index);
+    component_version.fetch_add(1, std::memory_order_release);
 }
 
 
@@ -89,8 +118,113 @@ void Warehouse::add_component(const std::string& component_id, int quantity) {
  */
 int Warehouse::get_component_quantity(const std::string& component_id) const {
     std::lock_guard<std::mutex> lock(inventory_mutex); // Lock inventory for read <----------
-    auto it = components.find(component_id);
-    return (it != components.end()) ? it->second : 0;
+    auto it = component_index.find(component_id);
+    return (it != component_index.end()) ? stock[it->second] : 0;
+}
+
+
+/**
+ * @brief Get (or assign) the dense index of a component; caller holds inventory_mutex
+ */
+int Warehouse::register_component_locked(const std::string& component_id) {
+    auto it = component_index.find(component_id);
+    if (it != component_index.end()) return it->second;
+    int index = (int)component_names.size();
+    component_index[component_id] = index;
+    component_names.push_back(component_id);
+    stock.push_back(0);
+    if (published_stock && !unpublished_logged) {
+        std::cerr << "Warning: Component " << component_id
+                  << " appeared after the stock gauges were published; it is missing from the metrics" << std::endl;
+        unpublished_logged = true;
+    }
+    return index;
+}
+
+
+/**
+ * @brief Size the lock-free stock view to every registered component and fill it
+ * Called once the BOMs are compiled and before any reader or simulation thread starts.
+ */
+void Warehouse::publish_components() {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    published_count.store(0, std::memory_order_release);
+    size_t count = component_names.size();
+    published_stock.reset(new std::atomic<int>[count]);
+    published_names.assign(component_names.begin(), component_names.end());
+    for (size_t i = 0; i < count; ++i) published_stock[i].store(stock[i], std::memory_order_relaxed);
+    published_count.store((int)count, std::memory_order_release);
+}
+
+
+/**
+ * @brief Copy a component's stock to the lock-free view; caller holds inventory_mutex
+ */
+void Warehouse::publish_locked(int index) {
+    if (index < published_count.load(std::memory_order_relaxed)) {
+        published_stock[index].store(stock[index], std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ * @brief Get (or assign) the dense index of a component
+ * @param component_id The ID of the component
+ * @return Dense component index
+ */
+int Warehouse::register_component(const std::string& component_id) {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    return register_component_locked(component_id);
+}
+
+
+/**
+ * @brief Find the dense index of a component
+ * @param component_id The ID of the component
+ * @return Dense component index, or -1 if unknown
+ */
+int Warehouse::find_component(const std::string& component_id) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    auto it = component_index.find(component_id);
+    return (it != component_index.end()) ? it->second : -1;
+}
+
+
+/**
+ * @brief Get the ID of a component from its index
+ * References stay valid because names are only ever appended to a deque.
+ * @param index Dense component index
+ * @return The component ID
+ */
+const std::string& Warehouse::component_name(int index) const {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    return component_names[index];
+}
+
+
+/**
+ * @brief Number of registered components (indices are 0..count-1)
+ */
+int Warehouse::component_count() const {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    return (int)component_names.size();
+}
+
+
+/**
+ * @brief Compile a product's BOM into a flat, index-based requirement array
+ * @param product The product to compile (flat_bom and total_units are filled)
+ */
+void Warehouse::compile_bom(Product& product) {
+    std::lock_guard<std::mutex> lock(inventory_mutex);
+    product.flat_bom.clear();
+    product.flat_bom.reserve(product.bom.size());
+    product.total_units = 0;
+    for (const auto& kv : product.bom) {
+        if (kv.second <= 0) continue;
+        product.flat_bom.push_back(BomLine{register_component_locked(kv.first), kv.second});
+        product.total_units += kv.second;
+    }
 }
 
 
@@ -126,8 +260,8 @@ void Warehouse::print_inventory() const {
 
     std::cout << "\n=== Warehouse Inventory ===\n";
     std::cout << "Components:\n";
-    for (const auto& comp : components) {
-        std::cout << "  " << comp.first << ": " << comp.second << std::endl;
+    for (const auto& comp : component_index) {
+        std::cout << "  " << comp.first << ": " << stock[comp.second] << std::endl;
     }
 
     std::cout << "\nFinished Products:\n";
@@ -136,18 +270,5 @@ void Warehouse::print_inventory() const {
     }
 }
 
-/**
- * @brief Log component availability for debugging
- * @param component_id The component to check
- * @param required_quantity The required quantity
- * @param available_quantity The available quantity
- */
-void Warehouse::log_component_availability(const std::string& component_id, int required_quantity, int available_quantity) const {
-    std::cout << "[Warehouse] Component " << component_id
-              << " - Required: " << required_quantity
-              << ", Available: " << available_quantity
-              << (available_quantity >= required_quantity ? " (OK)" : " (INSUFFICIENT)") << std::endl;
-}
-
 
 /*************************************************************************************/
\ No newline at end of file
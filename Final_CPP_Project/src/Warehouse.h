@@ -9,29 +9,60 @@
 /*****************************Standard Libraries***************************************/
 #include <string>
 #include <map>
+#include <deque>
+#include <vector>
 #include <mutex>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 #include <condition_variable>
 /*************************************************************************************/
 
+/******************************Project Headers*****************************************/
+#include "Product.h"
+/*************************************************************************************/
+
 /*****************************Warehouse Class Definition*******************************/
 class Warehouse {
 private:
-    std::map<std::string, int> components;      // component_id -> quantity
+    std::map<std::string, int> component_index; // component_id -> dense index
+    std::deque<std::string> component_names;    // index -> component_id (stable references)
+    std::vector<int> stock;                     // index -> quantity
     std::map<std::string, int> finished_products; // product_id -> quantity
     mutable std::mutex inventory_mutex;
+    std::atomic<uint64_t> component_version;    // Bumped whenever component stock increases
+
+    // Stock copy for lock-free readers (metrics); sized by publish_components, written under inventory_mutex
+    std::unique_ptr<std::atomic<int>[]> published_stock;
+    std::vector<std::string> published_names;
+    std::atomic<int> published_count;
+    bool unpublished_logged;                    // Warned once about components registered after publishing
+    void publish_locked(int index);
 
-    void log_component_availability(const std::string& component_id,
-                                    int required_quantity,
-                                    int available_quantity) const;
+    int register_component_locked(const std::string& component_id);
     
 public:
     Warehouse();
     
     // Component management
     bool has_components(const std::map<std::string, int>& required);
-    bool reserve_components(const std::map<std::string, int>& required);  // Checks and reserves atomically
+    // Check and reserve atomically; on failure *shortage = first short component and missing units
+    bool reserve_components(const std::map<std::string, int>& required, BomLine* shortage = nullptr);
+    bool reserve_components(const std::vector<BomLine>& required, BomLine* shortage = nullptr);  // Same, on a compiled BOM
     void add_component(const std::string& component_id, int quantity);
     int get_component_quantity(const std::string& component_id) const;
+    // Component indexing (compiled BOMs)
+    int register_component(const std::string& component_id);
+    int find_component(const std::string& component_id) const;
+    const std::string& component_name(int index) const;
+    int component_count() const;
+    void compile_bom(Product& product);
+    uint64_t get_component_version() const { return component_version.load(std::memory_order_acquire); }
+    // Lock-free stock view of the components known when publish_components was called
+    void publish_components();
+    int published_component_count() const { return published_count.load(std::memory_order_acquire); }
+    const std::string& published_component_name(int index) const { return published_names[index]; }
+    int peek_component_quantity(int index) const { return published_stock[index].load(std::memory_order_relaxed); }
     
     // Finished product management
     void add_finished_product(const std::string& product_id);
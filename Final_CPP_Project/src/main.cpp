@@ -11,27 +11,688 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <climits>
+#include <cmath>
 /*************************************************************************************/
 
 /*****************************Project Headers*****************************************/
-#include "ControlCenter.h"
-#include "AssemblyStation.h"
-#include "Warehouse.h"
-#include "AGV.h"
+#include "SimulationRunner.h"
 #include "FileHandler.h"
+#include "FastSimulator.h"
+#include "SequenceOptimizer.h"
+#include "ReplicationRunner.h"
+#include "ParameterSweep.h"
+#include "EventTrace.h"
+#include "ScenarioImage.h"
+#include "ScenarioGenerator.h"
+#include "SimCheckpoint.h"
+#include "TextScan.h"
 /*************************************************************************************/
 
 /********************************Variables********************************************/
 const int NUM_AGVS = 10;  // Use 2 AGVs for debugging (set to >=10 to meet assignment requirement)
 const int NUM_ASSEMBLY_LINES = 1;
+const int CONWIP_WIP_CAP = 0;  // Max orders in the system (0 = release on timestamp only)
 const std::string ORDERS_FILE = "input/orders.txt";
 const std::string BOM_FILE = "input/bom.txt";
 const std::string WAREHOUSE_FILE = "input/warehouse.txt";
 const std::string LOG_FILE = "output/sim_log.txt";
 const std::string KPI_REPORT_FILE = "output/kpi_report.txt";
+const std::string KPI_JSON_FILE = "output/kpi_report.json";
+const std::string ORDER_RESULTS_FILE = "output/order_results.csv";
+const std::string SEQUENCE_REPORT_FILE = "output/optimized_sequence.txt";
+const std::string REPLICATION_REPORT_FILE = "output/replications.txt";
+const std::string SWEEP_RESULTS_FILE = "output/sweep_results.csv";
+const std::string TRACE_FILE = "output/sim_trace.bin";
+const std::string SCENARIO_FILE = "output/scenario.scn";
+const std::string GENERATED_DIR = "output/generated";
+const std::string CHECKPOINT_FILE = "output/sim.ckpt";
+const int STREAM_ORDER_CAPACITY = 10000;  // Max orders (sub-assemblies included) in a streamed run
 
 /*************************************************************************************/
 
+/*******************************Option Parsing****************************************/
+/**
+ * @brief Check that the options after a subcommand come in --key value pairs
+ * @return false (with an error printed) if the last option has no value
+ */
+bool check_option_pairs(int argc, char* argv[], const char* command) {
+    if (argc > 2 && (argc - 2) % 2 != 0) {
+        std::cerr << "Error: Missing value for " << command << " option " << argv[argc - 1] << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse --conwip N (0 = no cap)
+ * @return false if the value is not a non-negative integer
+ */
+bool parse_conwip_cap(const std::string& text, int& cap) {
+    int value = 0;
+    if (!parse_number(std::string_view(text), value) || value < 0) return false;
+    cap = value;
+    return true;
+}
+
+/**
+ * @brief Parse --kanban FAMILY=N[,FAMILY=N...] into cards per product family
+ * A family with 0 cards could never release an order, so N must be at least 1.
+ * @return false if an entry is malformed
+ */
+bool parse_kanban_cards(const std::string& text, std::map<std::string, int>& cards) {
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        std::string_view entry = std::string_view(text).substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        size_t equals = entry.find('=');
+        int count = 0;
+        if (equals == 0 || equals == std::string_view::npos || !parse_number(entry.substr(equals + 1), count) || count < 1) {
+            return false;
+        }
+        cards[std::string(entry.substr(0, equals))] = count;
+        if (comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return true;
+}
+/*************************************************************************************/
+
+/*******************************Fast Simulator Modes**********************************/
+
+/**
+ * @brief Read the input files for the fast simulator modes
+ * @return true if all files were read
+ */
+bool load_fast_inputs(std::vector<Order>& orders, std::map<std::string, Product>& products,
+                      std::map<std::string, int>& inventory) {
+    return FileHandler::read_orders_file(ORDERS_FILE, orders) &&
+           FileHandler::read_bom_file(BOM_FILE, products) &&
+           FileHandler::read_warehouse_file(WAREHOUSE_FILE, inventory);
+}
+
+/**
+ * @brief Build the fast simulator from a compiled scenario or from the input files
+ * @param scenario_file Scenario image ("" = read the text input files)
+ * @param config Cell parameters; a scenario's layout replaces fleet, lines and times
+ * @return The simulator, or nullptr if the inputs could not be read
+ */
+std::unique_ptr<FastSimulator> make_fast_simulator(const std::string& scenario_file, FastSimConfig& config) {
+    if (!scenario_file.empty()) {
+        ScenarioImage image;
+        if (!image.open(scenario_file)) return nullptr;
+        apply_scenario_layout(image.layout(), config);
+        return std::unique_ptr<FastSimulator>(new FastSimulator(image, config));
+    }
+    std::vector<Order> orders;
+    std::map<std::string, Product> products;
+    std::map<std::string, int> inventory;
+    if (!load_fast_inputs(orders, products, inventory)) return nullptr;
+    return std::unique_ptr<FastSimulator>(new FastSimulator(orders, products, inventory, config));
+}
+
+/**
+ * @brief Search the best release/line sequence with the fast simulator
+ * Usage: fas_simulator optimize [--method sa|tabu] [--objective tardiness|makespan]
+ *                               [--iterations N] [--threads N] [--seed N] [--scenario FILE]
+ * @return Process exit code
+ */
+int run_optimizer(int argc, char* argv[]) {
+    OptimizerConfig config;
+    std::string scenario_file;
+    if (!check_option_pairs(argc, argv, "optimize")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        bool valid = true;
+        if (key == "--method") {
+            if (!parse_optimizer_method(value, config.method)) {
+                std::cerr << "Error: Unknown optimizer method " << value << " (expected sa or tabu)" << std::endl;
+                return 1;
+            }
+        } else if (key == "--objective") {
+            if (!parse_optimizer_objective(value, config.objective)) {
+                std::cerr << "Error: Unknown optimizer objective " << value << " (expected tardiness or makespan)" << std::endl;
+                return 1;
+            }
+        } else if (key == "--iterations") {
+            valid = parse_number(std::string_view(value), config.iterations) && config.iterations >= 1;
+        } else if (key == "--threads") {
+            valid = parse_number(std::string_view(value), config.threads) && config.threads >= 0;
+        } else if (key == "--seed") {
+            valid = parse_number(std::string_view(value), config.seed);
+        } else if (key == "--scenario") {
+            scenario_file = value;
+        } else {
+            std::cerr << "Error: Unknown optimizer option " << key << std::endl;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid value for " << key << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    FastSimConfig sim_config;
+    sim_config.num_agvs = NUM_AGVS;
+    sim_config.num_lines = NUM_ASSEMBLY_LINES;
+    std::unique_ptr<FastSimulator> fast_simulator = make_fast_simulator(scenario_file, sim_config);
+    if (!fast_simulator) {
+        return 1;
+    }
+    const FastSimulator& simulator = *fast_simulator;
+    SequenceOptimizer optimizer(simulator, config);
+
+    std::cout << "Optimizing " << simulator.order_count() << " orders with " << to_string(config.method)
+              << " (objective: " << to_string(config.objective) << ")...\n";
+    FastSimResult baseline = simulator.evaluate(simulator.default_plan());
+    OptimizerResult best = optimizer.run();
+
+    std::cout << "Baseline (release order): makespan " << baseline.makespan_minutes
+              << " min, total tardiness " << baseline.total_tardiness << " min\n";
+    std::cout << "Best sequence: makespan " << best.kpis.makespan_minutes
+              << " min, total tardiness " << best.kpis.total_tardiness
+              << " min, avg lead time " << best.kpis.avg_lead_time
+              << " min (" << best.evaluations << " evaluations)\n";
+
+    std::string header = std::string("Method: ") + to_string(config.method)
+                       + ", Objective: " + to_string(config.objective)
+                       + ", Evaluations: " + std::to_string(best.evaluations);
+    if (!FileHandler::write_sequence_report(SEQUENCE_REPORT_FILE, simulator, best.plan, best.kpis, header)) {
+        return 1;
+    }
+    std::cout << "Check " << SEQUENCE_REPORT_FILE << " for the optimized sequence\n";
+    return 0;
+}
+
+
+/**
+ * @brief Run independent stochastic replications and report KPI confidence intervals
+ * Usage: fas_simulator replicate [--replications N] [--threads N] [--seed N] [--confidence P]
+ *                                [--distribution constant|uniform|triangular|lognormal]
+ *                                [--processing-spread X] [--travel-spread X] [--scenario FILE]
+ * @return Process exit code
+ */
+int run_replications(int argc, char* argv[]) {
+    ReplicationConfig config;
+    std::string scenario_file;
+    FastSimConfig sim_config;
+    sim_config.num_agvs = NUM_AGVS;
+    sim_config.num_lines = NUM_ASSEMBLY_LINES;
+    sim_config.processing_distribution = sim_config.travel_distribution = TimeDistribution::TRIANGULAR;
+    sim_config.processing_spread = sim_config.travel_spread = 0.2;
+    if (!check_option_pairs(argc, argv, "replicate")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        bool valid = true;
+        if (key == "--replications") {
+            valid = parse_number(std::string_view(value), config.replications) && config.replications >= 2;
+        } else if (key == "--threads") {
+            valid = parse_number(std::string_view(value), config.threads) && config.threads >= 0;
+        } else if (key == "--seed") {
+            valid = parse_number(std::string_view(value), config.seed);
+        } else if (key == "--confidence") {
+            valid = parse_number(std::string_view(value), config.confidence)
+                 && config.confidence > 0.0 && config.confidence < 1.0;
+        } else if (key == "--distribution") {
+            if (!parse_time_distribution(value, sim_config.processing_distribution)) {
+                std::cerr << "Error: Unknown distribution " << value << std::endl;
+                return 1;
+            }
+            sim_config.travel_distribution = sim_config.processing_distribution;
+        } else if (key == "--processing-spread") {
+            valid = parse_number(std::string_view(value), sim_config.processing_spread)
+                 && std::isfinite(sim_config.processing_spread) && sim_config.processing_spread >= 0.0;
+        } else if (key == "--travel-spread") {
+            valid = parse_number(std::string_view(value), sim_config.travel_spread)
+                 && std::isfinite(sim_config.travel_spread) && sim_config.travel_spread >= 0.0;
+        } else if (key == "--scenario") {
+            scenario_file = value;
+        } else {
+            std::cerr << "Error: Unknown replication option " << key << std::endl;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid value for " << key << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    std::unique_ptr<FastSimulator> fast_simulator = make_fast_simulator(scenario_file, sim_config);
+    if (!fast_simulator) {
+        return 1;
+    }
+    const FastSimulator& simulator = *fast_simulator;
+    ReplicationRunner runner(simulator, config);
+    std::cout << "Running " << config.replications << " replications of " << simulator.order_count() << " orders ("
+              << to_string(sim_config.processing_distribution) << ", processing spread " << sim_config.processing_spread
+              << ", travel spread " << sim_config.travel_spread << ")...\n";
+    ReplicationResult result = runner.run(simulator.default_plan());
+
+    std::cout << "KPI means with " << (config.confidence * 100) << "% confidence intervals:\n";
+    for (const KpiEstimate& e : result.estimates) {
+        std::cout << "   " << e.name << ": " << e.mean << " +/- " << e.half_width << "\n";
+    }
+
+    std::string header = "Replications: " + std::to_string(config.replications)
+                       + ", Seed: " + std::to_string(config.seed)
+                       + ", Confidence: " + std::to_string(config.confidence)
+                       + ", Distribution: " + to_string(sim_config.processing_distribution)
+                       + ", Processing spread: " + std::to_string(sim_config.processing_spread)
+                       + ", Travel spread: " + std::to_string(sim_config.travel_spread);
+    if (!FileHandler::write_replication_report(REPLICATION_REPORT_FILE, result, header)) {
+        return 1;
+    }
+    std::cout << "Check " << REPLICATION_REPORT_FILE << " for all replications\n";
+    return 0;
+}
+
+/**
+ * @brief Parse a comma-separated list of integers
+ * @return false if any entry is not a positive integer
+ */
+bool parse_int_list(const std::string& text, std::vector<int>& values) {
+    values.clear();
+    for (const std::string& token : FileHandler::split_string(text, ',')) {
+        int value = std::atoi(token.c_str());
+        if (value <= 0) return false;
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+
+/**
+ * @brief Evaluate every combination of AGV count, line count, policy and input set
+ * Usage: fas_simulator sweep [--agvs 5,10,15] [--lines 1,2] [--policies FIFO,EDD,ATC]
+ *                            [--inputs input,other_dir] [--threads N]
+ * Each input directory holds orders.txt, bom.txt and warehouse.txt; an input
+ * ending in .scn is a compiled scenario (see compile-scenario).
+ * @return Process exit code
+ */
+int run_sweep(int argc, char* argv[]) {
+    SweepGrid grid;
+    grid.agv_counts = {NUM_AGVS};
+    grid.line_counts = {NUM_ASSEMBLY_LINES};
+    std::vector<std::string> input_dirs{"input"};
+    if (!check_option_pairs(argc, argv, "sweep")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        bool valid = true;
+        if (key == "--agvs") {
+            valid = parse_int_list(value, grid.agv_counts);
+        } else if (key == "--lines") {
+            valid = parse_int_list(value, grid.line_counts);
+        } else if (key == "--policies") {
+            grid.policies.clear();
+            for (const std::string& name : FileHandler::split_string(value, ',')) {
+                SchedulingPolicy policy;
+                if (!parse_scheduling_policy(name, policy)) { valid = false; break; }
+                grid.policies.push_back(policy);
+            }
+        } else if (key == "--inputs") {
+            input_dirs = FileHandler::split_string(value, ',');
+        } else if (key == "--threads") {
+            grid.threads = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Error: Unknown sweep option " << key << std::endl;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid value for " << key << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<SweepInput> inputs(input_dirs.size());
+    for (size_t i = 0; i < input_dirs.size(); ++i) {
+        const std::string& dir = input_dirs[i];
+        inputs[i].name = dir;
+        if (dir.size() > 4 && dir.compare(dir.size() - 4, 4, ".scn") == 0) {
+            std::shared_ptr<ScenarioImage> image = std::make_shared<ScenarioImage>();
+            if (!image->open(dir)) {
+                return 1;
+            }
+            inputs[i].image = image;
+            continue;
+        }
+        if (!FileHandler::read_orders_file(dir + "/orders.txt", inputs[i].orders) ||
+            !FileHandler::read_bom_file(dir + "/bom.txt", inputs[i].products) ||
+            !FileHandler::read_warehouse_file(dir + "/warehouse.txt", inputs[i].inventory)) {
+            return 1;
+        }
+    }
+
+    ParameterSweep sweep(inputs, grid);
+    std::cout << "Sweeping " << inputs.size() * grid.agv_counts.size() * grid.line_counts.size() * grid.policies.size()
+              << " configurations...\n";
+    std::vector<SweepPoint> points = sweep.run();
+
+    std::cout << "input       AGVs  lines  policy          lead time  makespan  tardiness\n";
+    for (const SweepPoint& point : points) {
+        std::printf("%-10s %5d %6d  %-14s %10.1f %9d %10lld\n", inputs[point.input_index].name.c_str(),
+                    point.num_agvs, point.num_lines, to_string(point.policy),
+                    point.kpis.avg_lead_time, point.kpis.makespan_minutes, point.kpis.total_tardiness);
+    }
+    if (!FileHandler::write_sweep_results(SWEEP_RESULTS_FILE, inputs, points)) {
+        return 1;
+    }
+    std::cout << "Sweep complete. Check " << SWEEP_RESULTS_FILE << " for the results table\n";
+    return 0;
+}
+
+
+/**
+ * @brief Format minutes as HH:MM for console output
+ */
+std::string format_clock(int minutes) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d:%02d", minutes / 60, minutes % 60);
+    return text;
+}
+
+
+/**
+ * @brief Run the fast model under a dispatch rule, optionally stopping at a checkpoint or resuming one
+ * Usage: fas_simulator simulate [--policy NAME] [--until HH:MM] [--checkpoint FILE] [--resume FILE]
+ *                               [--scenario FILE] [--distribution NAME] [--spread X] [--seed N]
+ *                               [--conwip N] [--kanban FAMILY=N[,FAMILY=N...]]
+ * With --until the run stops once the staging clock reaches that time and its
+ * full state is written to --checkpoint (default output/sim.ckpt). --resume
+ * continues a checkpoint; use the same scenario and cell options, and a
+ * different --policy to fork the run.
+ * @return Process exit code
+ */
+int run_fast_simulation(int argc, char* argv[]) {
+    SchedulingPolicy policy = SchedulingPolicy::FIFO;
+    int until_minutes = INT_MAX;
+    std::string checkpoint_file = CHECKPOINT_FILE;
+    std::string resume_file;
+    std::string scenario_file;
+    uint64_t seed = 1;
+    FastSimConfig sim_config;
+    sim_config.num_agvs = NUM_AGVS;
+    sim_config.num_lines = NUM_ASSEMBLY_LINES;
+    if (!check_option_pairs(argc, argv, "simulate")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        bool valid = true;
+        if (key == "--policy") {
+            valid = parse_scheduling_policy(value, policy);
+        } else if (key == "--until") {
+            valid = FileHandler::parse_clock(value, until_minutes);
+        } else if (key == "--checkpoint") {
+            checkpoint_file = value;
+        } else if (key == "--resume") {
+            resume_file = value;
+        } else if (key == "--scenario") {
+            scenario_file = value;
+        } else if (key == "--distribution") {
+            valid = parse_time_distribution(value, sim_config.processing_distribution);
+            sim_config.travel_distribution = sim_config.processing_distribution;
+        } else if (key == "--spread") {
+            sim_config.processing_spread = sim_config.travel_spread = std::atof(value.c_str());
+        } else if (key == "--seed") {
+            seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "--conwip") {
+            valid = parse_conwip_cap(value, sim_config.conwip_cap);
+        } else if (key == "--kanban") {
+            valid = parse_kanban_cards(value, sim_config.kanban_cards);
+        } else {
+            std::cerr << "Error: Unknown simulate option " << key << std::endl;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid value for " << key << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    std::unique_ptr<FastSimulator> fast_simulator = make_fast_simulator(scenario_file, sim_config);
+    if (!fast_simulator) {
+        return 1;
+    }
+    const FastSimulator& simulator = *fast_simulator;
+    FastSimState state = simulator.start_run();
+    if (!resume_file.empty()) {
+        std::string error;
+        if (!SimCheckpoint::load(resume_file, state)) {
+            return 1;
+        }
+        if (!simulator.check_state(state, error)) {
+            std::cerr << "Error: Cannot resume " << resume_file << ": " << error << std::endl;
+            return 1;
+        }
+    } else if (sim_config.processing_distribution != TimeDistribution::CONSTANT) {
+        state.stochastic = true;
+        state.rng = FastRng(seed);
+    }
+
+    auto rule = make_dispatch_rule(policy, simulator.mean_processing_time());
+    std::cout << "Simulating " << simulator.order_count() << " orders with " << to_string(policy)
+              << (resume_file.empty() ? "" : " from " + format_clock(state.clock) + " (" + resume_file + ")")
+              << (until_minutes == INT_MAX ? "" : " until " + format_clock(until_minutes)) << "...\n";
+    bool finished = simulator.advance(state, *rule, until_minutes);
+    FastSimResult kpis = simulator.finish_run(state);
+
+    if (!finished) {
+        size_t pending = 0, released = 0;
+        for (OrderState order_state : state.order_states) {
+            if (order_state == OrderState::PENDING) pending++;
+            else if (order_state == OrderState::RELEASED) released++;
+        }
+        if (!SimCheckpoint::save(checkpoint_file, state)) {
+            return 1;
+        }
+        std::cout << "Stopped at " << format_clock(state.clock) << ": " << kpis.completed << " completed, "
+                  << kpis.canceled << " canceled, " << released << " released, " << pending << " pending\n";
+        std::cout << "Checkpoint written to " << checkpoint_file << "\n";
+        return 0;
+    }
+    std::cout << "Run complete: " << kpis.completed << " completed, " << kpis.canceled << " canceled, makespan "
+              << kpis.makespan_minutes << " min, avg lead time " << kpis.avg_lead_time << " min, total tardiness "
+              << kpis.total_tardiness << " min\n";
+    return 0;
+}
+/*************************************************************************************/
+
+/*******************************Scenario Compiler*************************************/
+/**
+ * @brief Compile the text input files and the cell layout into a binary scenario image
+ * Usage: fas_simulator compile-scenario [--input DIR] [--output FILE]
+ * The image loads without parsing: pass it to optimize/replicate/run with
+ * --scenario FILE, or list it in sweep --inputs.
+ * @return Process exit code
+ */
+int run_scenario_compiler(int argc, char* argv[]) {
+    std::string input_dir = "input";
+    std::string output_file = SCENARIO_FILE;
+    if (!check_option_pairs(argc, argv, "compile-scenario")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        if (key == "--input") {
+            input_dir = value;
+        } else if (key == "--output") {
+            output_file = value;
+        } else {
+            std::cerr << "Error: Unknown compile-scenario option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Order> orders;
+    std::map<std::string, Product> products;
+    std::map<std::string, int> inventory;
+    if (!FileHandler::read_orders_file(input_dir + "/orders.txt", orders) ||
+        !FileHandler::read_bom_file(input_dir + "/bom.txt", products) ||
+        !FileHandler::read_warehouse_file(input_dir + "/warehouse.txt", inventory)) {
+        return 1;
+    }
+    FastSimConfig layout;
+    layout.num_agvs = NUM_AGVS;
+    layout.num_lines = NUM_ASSEMBLY_LINES;
+    if (!ScenarioImage::compile(output_file, orders, products, inventory, to_scenario_layout(layout))) {
+        return 1;
+    }
+
+    ScenarioImage image;
+    if (!image.open(output_file)) {     //Check what was written
+        return 1;
+    }
+    std::cout << "Compiled " << image.order_count() << " orders, " << image.product_count() << " products and "
+              << image.component_count() << " components from " << input_dir << " into " << output_file << "\n";
+    return 0;
+}
+/*************************************************************************************/
+
+/*******************************Scenario Generator************************************/
+/**
+ * @brief Parse "MIN,MAX" into a pair of numbers
+ * @return false unless there are exactly two numeric entries
+ */
+template <typename T>
+bool parse_range(const std::string& text, T& low, T& high) {
+    std::vector<std::string> tokens = FileHandler::split_string(text, ',');
+    return tokens.size() == 2 && parse_number(std::string_view(tokens[0]), low)
+        && parse_number(std::string_view(tokens[1]), high);
+}
+
+
+/**
+ * @brief Write a synthetic, seed-reproducible input set for stress runs
+ * Usage: fas_simulator generate-scenario [--output DIR] [--seed N] [--orders N] [--products N]
+ *                                        [--components N] [--bom-width N] [--bom-depth N]
+ *                                        [--subassemblies N] [--max-quantity N] [--base-time MIN,MAX]
+ *                                        [--arrivals poisson|uniform|burst] [--rate ORDERS_PER_HOUR]
+ *                                        [--burst-size N] [--priorities N]
+ *                                        [--priority-distribution uniform|skewed] [--due-fraction P]
+ *                                        [--due-slack MIN,MAX] [--stock-factor X] [--image FILE]
+ * DIR receives orders.txt, bom.txt and warehouse.txt (usable with sweep --inputs);
+ * --image also compiles them into a scenario image.
+ * @return Process exit code
+ */
+int run_scenario_generator(int argc, char* argv[]) {
+    GeneratorConfig config;
+    std::string output_dir = GENERATED_DIR;
+    std::string image_file;
+    if (!check_option_pairs(argc, argv, "generate-scenario")) {
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        bool valid = true;
+        if (key == "--output") {
+            output_dir = value;
+        } else if (key == "--seed") {
+            valid = parse_number(std::string_view(value), config.seed);
+        } else if (key == "--orders") {
+            valid = parse_number(std::string_view(value), config.orders);
+        } else if (key == "--products") {
+            valid = parse_number(std::string_view(value), config.products);
+        } else if (key == "--components") {
+            valid = parse_number(std::string_view(value), config.components);
+        } else if (key == "--bom-width") {
+            valid = parse_number(std::string_view(value), config.bom_width);
+        } else if (key == "--bom-depth") {
+            valid = parse_number(std::string_view(value), config.bom_depth);
+        } else if (key == "--subassemblies") {
+            valid = parse_number(std::string_view(value), config.subassembly_width);
+        } else if (key == "--max-quantity") {
+            valid = parse_number(std::string_view(value), config.max_quantity);
+        } else if (key == "--base-time") {
+            valid = parse_range(value, config.min_base_time, config.max_base_time);
+        } else if (key == "--arrivals") {
+            valid = parse_arrival_process(value, config.arrivals);
+        } else if (key == "--rate") {
+            valid = parse_number(std::string_view(value), config.arrival_rate) && std::isfinite(config.arrival_rate);
+        } else if (key == "--burst-size") {
+            valid = parse_number(std::string_view(value), config.burst_size);
+        } else if (key == "--priorities") {
+            valid = parse_number(std::string_view(value), config.priority_levels);
+        } else if (key == "--priority-distribution") {
+            valid = parse_priority_distribution(value, config.priorities);
+        } else if (key == "--due-fraction") {
+            valid = parse_number(std::string_view(value), config.due_fraction) && std::isfinite(config.due_fraction);
+        } else if (key == "--due-slack") {
+            valid = parse_range(value, config.due_slack_min, config.due_slack_max)
+                 && std::isfinite(config.due_slack_min) && std::isfinite(config.due_slack_max);
+        } else if (key == "--stock-factor") {
+            valid = parse_number(std::string_view(value), config.stock_factor) && std::isfinite(config.stock_factor);
+        } else if (key == "--image") {
+            image_file = value;
+        } else {
+            std::cerr << "Error: Unknown generate-scenario option " << key << std::endl;
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid value for " << key << ": " << value << std::endl;
+            return 1;
+        }
+    }
+
+    ScenarioGenerator generator(config);
+    std::string error;
+    if (!generator.validate(error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    std::vector<Order> orders;
+    std::map<std::string, Product> products;
+    std::map<std::string, int> inventory;
+    generator.generate(orders, products, inventory);
+
+    if (!FileHandler::create_directory(output_dir) ||
+        !FileHandler::write_orders_file(output_dir + "/orders.txt", orders) ||
+        !FileHandler::write_bom_file(output_dir + "/bom.txt", products) ||
+        !FileHandler::write_warehouse_file(output_dir + "/warehouse.txt", inventory)) {
+        return 1;
+    }
+    if (!image_file.empty()) {
+        FastSimConfig layout;
+        layout.num_agvs = NUM_AGVS;
+        layout.num_lines = NUM_ASSEMBLY_LINES;
+        if (!ScenarioImage::compile(image_file, orders, products, inventory, to_scenario_layout(layout))) {
+            return 1;
+        }
+    }
+    std::cout << "Generated " << orders.size() << " orders (" << to_string(config.arrivals) << " arrivals, "
+              << to_string(config.priorities) << " priorities), " << products.size() << " products in "
+              << config.bom_depth << " BOM level(s) and " << inventory.size() << " components into " << output_dir
+              << (image_file.empty() ? "" : " and " + image_file) << " (seed " << config.seed << ")\n";
+    return 0;
+}
+/*************************************************************************************/
+
+/*******************************Trace Decoder*****************************************/
+/**
+ * @brief Regenerate the text log from a binary event trace
+ * Usage: fas_simulator decode-trace [TRACE_FILE] [LOG_FILE]
+ * @return Process exit code
+ */
+int run_trace_decoder(int argc, char* argv[]) {
+    std::string trace_file = (argc > 2) ? argv[2] : TRACE_FILE;
+    std::string log_file = (argc > 3) ? argv[3] : LOG_FILE;
+    long events = EventTrace::decode(trace_file, log_file);
+    if (events < 0) {
+        return 1;
+    }
+    std::cout << "Decoded " << events << " events from " << trace_file << " into " << log_file << "\n";
+    return 0;
+}
+/*************************************************************************************/
+
 /*******************************Main Function*****************************************/
 int main(int argc, char* argv[]) {
     std::cout << "========================================\n";
@@ -45,69 +706,137 @@ int main(int argc, char* argv[]) {
 #else
     system("mkdir -p output");
 #endif
-    
-    // Initialize core components
-    Warehouse warehouse;
-    std::vector<AGV*> agv_fleet; //To hold AGV pointers 
-    ControlCenter control_center; 
-    AssemblyStation assembly_station(&warehouse, &agv_fleet);
-    assembly_station.set_station_count(NUM_ASSEMBLY_LINES); 
-    
-    // Load input files
-    std::cout << "Loading input files...\n";
-    if (!control_center.load_orders(ORDERS_FILE)) {
-        std::cerr << "Error: Failed to load orders file: " << ORDERS_FILE << std::endl;
-        return 1;
+
+    if (argc > 1 && std::string(argv[1]) == "optimize") {
+        return run_optimizer(argc, argv);
     }
-    std::cout << "   Loaded orders from " << ORDERS_FILE << std::endl;
-    
-    if (!control_center.load_bom(BOM_FILE)) {
-        std::cerr << "Error: Failed to load BOM file: " << BOM_FILE << std::endl;
-        return 1;
+    if (argc > 1 && std::string(argv[1]) == "replicate") {
+        return run_replications(argc, argv);
     }
-    std::cout << "   Loaded BOM from " << BOM_FILE << std::endl;
-    
-    if (!control_center.load_warehouse(WAREHOUSE_FILE, &warehouse)) {
-        std::cerr << "Error: Failed to load warehouse file: " << WAREHOUSE_FILE << std::endl;
-        return 1;
+    if (argc > 1 && std::string(argv[1]) == "sweep") {
+        return run_sweep(argc, argv);
     }
-    std::cout << "   Loaded warehouse inventory from " << WAREHOUSE_FILE << std::endl;
-    
-    // Create AGV fleet (threads will be started by ControlCenter)
-    std::cout << "\nInitializing AGV fleet (" << NUM_AGVS << " AGVs)...\n";
-    for (int i = 1; i <= NUM_AGVS; i++) {
-        AGV* agv = new AGV(i);
-        agv_fleet.push_back(agv);
-        std::cout << "   AGV" << i << " initialized\n";
+    if (argc > 1 && std::string(argv[1]) == "decode-trace") {
+        return run_trace_decoder(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "simulate") {
+        return run_fast_simulation(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "generate-scenario") {
+        return run_scenario_generator(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "compile-scenario") {
+        return run_scenario_compiler(argc, argv);
     }
-    
-    // Set scheduling policy (default: FIFO, but using PRIORITY for better resource management)
-    control_center.set_scheduling_policy(SchedulingPolicy::PRIORITY);
 
-    // Optional: silence diagnostics for final runs
-    // control_center.set_diag_logging(false);
-    
-    // Start simulation (ControlCenter wires station and starts all threads)
-    std::cout << "\nStarting simulation...\n";
-    std::cout << "========================================\n";
-    control_center.start_simulation(&assembly_station, &agv_fleet);
-    
-    // Wait until all released orders complete instead of sleeping
-    //To reduce the simulation time
-    control_center.wait_until_all_orders_complete();
-    
-    // Stop everything via ControlCenter (it will stop station and AGVs)
-    std::cout << "\nStopping simulation...\n";
-    control_center.stop_simulation();
-    
-    // Cleanup AGV objects
-    for (auto* agv : agv_fleet) {
-        delete agv;
+    // Optional live metrics: fas_simulator --metrics-socket output/fas_metrics.sock
+    // Optional binary event trace instead of the text log: fas_simulator --trace output/sim_trace.bin
+    // Optional Perfetto/Chrome timeline: fas_simulator --chrome-trace output/timeline.json
+    // Runtime log level: --log-level off|info|diag (levels above FAS_LOG_LEVEL are compiled out)
+    // Streamed orders instead of orders.txt: --stream-orders PATH [--follow] [--stream-capacity N]
+    // Compiled inputs and layout instead of input/*.txt: --scenario output/scenario.scn
+    // Other input files: --orders FILE, --bom FILE (e.g. input/bom_multilevel.txt), --warehouse FILE
+    // Release control: --conwip N (max orders in the cell), --kanban FAMILY=N[,FAMILY=N...] (repeatable)
+    // Log and reports in another directory than output/: --output-dir DIR
+    SimulationConfig config;
+    config.orders_file = ORDERS_FILE;
+    config.bom_file = BOM_FILE;
+    config.warehouse_file = WAREHOUSE_FILE;
+    config.log_file = LOG_FILE;
+    config.kpi_report_file = KPI_REPORT_FILE;
+    config.kpi_json_file = KPI_JSON_FILE;
+    config.order_results_file = ORDER_RESULTS_FILE;
+    config.num_agvs = NUM_AGVS;
+    config.num_lines = NUM_ASSEMBLY_LINES;
+    config.policy = SchedulingPolicy::PRIORITY;     // Default FIFO; PRIORITY for better resource management
+    config.conwip_cap = CONWIP_WIP_CAP;             // --conwip N overrides; --kanban FAMILY=N sets cards per product family
+    config.stream_capacity = STREAM_ORDER_CAPACITY;
+    config.verbose = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--metrics-socket" && i + 1 < argc) {
+            config.metrics_socket = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            config.trace_file = argv[++i];
+        } else if (arg == "--chrome-trace" && i + 1 < argc) {
+            config.chrome_trace_file = argv[++i];
+        } else if (arg == "--stream-orders" && i + 1 < argc) {
+            config.stream_file = argv[++i];
+        } else if (arg == "--scenario" && i + 1 < argc) {
+            config.scenario_file = argv[++i];
+        } else if (arg == "--orders" && i + 1 < argc) {
+            config.orders_file = argv[++i];
+        } else if (arg == "--bom" && i + 1 < argc) {
+            config.bom_file = argv[++i];
+        } else if (arg == "--warehouse" && i + 1 < argc) {
+            config.warehouse_file = argv[++i];
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            std::string dir = argv[++i];
+            if (!FileHandler::create_directory(dir)) return 1;
+            config.log_file = dir + "/sim_log.txt";
+            config.kpi_report_file = dir + "/kpi_report.txt";
+            config.kpi_json_file = dir + "/kpi_report.json";
+            config.order_results_file = dir + "/order_results.csv";
+        } else if (arg == "--conwip" && i + 1 < argc) {
+            if (!parse_conwip_cap(argv[++i], config.conwip_cap)) {
+                std::cerr << "Error: Invalid value for --conwip: " << argv[i] << " (expected a cap of 0 or more)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--kanban" && i + 1 < argc) {
+            if (!parse_kanban_cards(argv[++i], config.kanban_cards)) {
+                std::cerr << "Error: Invalid value for --kanban: " << argv[i] << " (expected FAMILY=N with N at least 1)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--follow") {
+            config.follow_stream = true;
+        } else if (arg == "--stream-capacity" && i + 1 < argc) {
+            int stream_capacity = std::atoi(argv[++i]);
+            if (stream_capacity <= 0) {
+                std::cerr << "Error: Invalid value for --stream-capacity: " << argv[i] << std::endl;
+                return 1;
+            }
+            config.stream_capacity = (size_t)stream_capacity;
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            if (!parse_log_level(argv[++i], config.log_level)) {
+                std::cerr << "Error: Invalid value for --log-level: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    SimulationRunner runner(config);
+    SimulationResult result;
+    if (!runner.run(result)) {
+        return 1;
     }
     
     std::cout << "\nSimulation complete!\n";
-    std::cout << "Check " << LOG_FILE << " for detailed logs\n";
-    std::cout << "Check " << KPI_REPORT_FILE << " for performance metrics\n";
+    std::cout << result.completed << " orders completed, " << result.canceled << " canceled, average lead time "
+              << result.kpis.avg_lead_time << " min\n";
+    if (config.conwip_cap > 0 || !config.kanban_cards.empty()) {
+        const KpiReport& kpis = result.kpis;
+        std::cout << "Release control: CONWIP cap " << (kpis.conwip_cap > 0 ? std::to_string(kpis.conwip_cap) : std::string("off"))
+                  << ", average WIP " << kpis.avg_wip << ", max WIP " << kpis.max_wip << ", throughput "
+                  << kpis.throughput << " orders/hour (" << (kpis.avg_wip > 0 ? kpis.throughput / kpis.avg_wip : 0.0)
+                  << " per WIP)\n";
+    }
+    if (result.subassemblies_completed + result.subassemblies_canceled > 0) {
+        std::cout << result.subassemblies_completed << " sub-assembly orders completed, "
+                  << result.subassemblies_canceled << " canceled\n";
+    }
+    if (config.trace_file.empty()) {
+        std::cout << "Check " << config.log_file << " for detailed logs\n";
+    } else {
+        std::cout << "Run 'fas_simulator decode-trace " << config.trace_file << " " << config.log_file << "' to write the log\n";
+    }
+    std::cout << "Check " << config.kpi_report_file << " for performance metrics\n";
+    std::cout << "Check " << config.kpi_json_file << " and " << config.order_results_file << " for machine-readable results\n";
+    if (!config.chrome_trace_file.empty()) {
+        std::cout << "Open " << config.chrome_trace_file << " in ui.perfetto.dev or chrome://tracing for the AGV/line timeline\n";
+    }
     std::cout << "========================================\n";
     
     return 0;
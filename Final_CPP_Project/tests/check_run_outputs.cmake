@@ -0,0 +1,144 @@
+# Checks the reports a default run wrote into OUTPUT_DIR (run by ctest):
+#   order_results.csv  header, one row per order, milestones in order on each clock
+#   kpi_report.json    percentiles ordered (p50 <= p90 <= p99 <= max), lead-time
+#                      percentiles within HDR precision of the exact values from the
+#                      CSV, and every queue's Little's-law length close to its average
+# Usage: cmake -DOUTPUT_DIR=dir -DEXPECTED_ORDERS=n -P check_run_outputs.cmake
+cmake_minimum_required(VERSION 3.19)   # string(JSON)
+
+# Decimal as printed by the reports (%.6g) -> integer thousandths
+function(to_milli value out_var)
+    if(NOT value MATCHES "^(-?)([0-9]+)(\\.([0-9]+))?(e([-+]?[0-9]+))?$")
+        message(FATAL_ERROR "Not a number: '${value}'")
+    endif()
+    set(sign "${CMAKE_MATCH_1}")
+    set(digits "${CMAKE_MATCH_2}${CMAKE_MATCH_4}")
+    set(exponent "${CMAKE_MATCH_6}")
+    if(exponent STREQUAL "")
+        set(exponent 0)
+    endif()
+    string(LENGTH "${CMAKE_MATCH_2}" point)
+    math(EXPR point "${point} + ${exponent} + 3")
+    if(point LESS_EQUAL 0)
+        set(${out_var} 0 PARENT_SCOPE)
+        return()
+    endif()
+    string(LENGTH "${digits}" length)
+    while(length LESS point)
+        string(APPEND digits "0")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    string(SUBSTRING "${digits}" 0 ${point} digits)
+    string(REGEX REPLACE "^0+([0-9])" "\\1" digits "${digits}")
+    set(${out_var} "${sign}${digits}" PARENT_SCOPE)
+endfunction()
+
+function(check condition_text)
+    if(NOT (${ARGN}))
+        message(FATAL_ERROR "Check failed: ${condition_text}")
+    endif()
+endfunction()
+
+# Value of the sorted list at a percentile, with the rank rule of HdrHistogram
+function(exact_percentile sorted percentile out_var)
+    list(LENGTH sorted count)
+    math(EXPR rank "(${percentile} * ${count} + 50) / 100")
+    if(rank LESS 1)
+        set(rank 1)
+    endif()
+    if(rank GREATER count)
+        set(rank ${count})
+    endif()
+    math(EXPR rank "${rank} - 1")
+    list(GET sorted ${rank} value)
+    set(${out_var} ${value} PARENT_SCOPE)
+endfunction()
+
+# --- order_results.csv ---
+file(STRINGS "${OUTPUT_DIR}/order_results.csv" rows)
+list(POP_FRONT rows header)
+check("CSV header" header STREQUAL
+      "order_id,product_id,parent_order_id,status,release,due_date,staged_agv_clock,kitted_agv_clock,start_line_clock,completion_line_clock,line,setup_minutes,agv_trips")
+list(LENGTH rows row_count)
+check("${row_count} CSV rows, expected ${EXPECTED_ORDERS}" row_count EQUAL EXPECTED_ORDERS)
+set(lead_times "")
+set(lead_sum 0)
+foreach(row IN LISTS rows)
+    string(REPLACE "," ";" fields "${row}")
+    list(GET fields 0 id)
+    list(GET fields 2 parent)
+    list(GET fields 3 status)
+    list(GET fields 4 release)
+    list(GET fields 6 staged)
+    list(GET fields 7 kitted)
+    list(GET fields 8 start)
+    list(GET fields 9 completion)
+    check("order ${id} completed" status STREQUAL "completed")
+    check("order ${id}: release <= staged <= kitted (AGV clock)" release LESS_EQUAL staged AND staged LESS_EQUAL kitted)
+    check("order ${id}: release <= start <= completion (line clock)" release LESS_EQUAL start AND start LESS_EQUAL completion)
+    if(parent EQUAL -1)
+        math(EXPR lead "${completion} - ${release}")
+        list(APPEND lead_times ${lead})
+        math(EXPR lead_sum "${lead_sum} + ${lead}")
+    endif()
+endforeach()
+list(SORT lead_times COMPARE NATURAL)
+list(LENGTH lead_times customer_orders)
+
+# --- kpi_report.json ---
+file(READ "${OUTPUT_DIR}/kpi_report.json" json)
+string(JSON average GET "${json}" avg_lead_time)
+to_milli(${average} average)
+math(EXPR exact_average "${lead_sum} * 1000 / ${customer_orders}")
+math(EXPR difference "${average} - ${exact_average}")
+check("avg_lead_time ${average} vs CSV ${exact_average} (thousandths)" difference LESS_EQUAL 1 AND difference GREATER_EQUAL -1)
+
+foreach(metric lead_time queue_wait kit_preparation agv_response)
+    set(previous 0)
+    foreach(field p50 p90 p99 max)
+        string(JSON value GET "${json}" percentiles ${metric} ${field})
+        to_milli(${value} value)
+        check("${metric} ${field} ordered" previous LESS_EQUAL value)
+        set(previous ${value})
+    endforeach()
+endforeach()
+
+# HDR buckets are 1/16 of their lower edge wide and report the midpoint: within ~3%
+string(JSON count GET "${json}" percentiles lead_time count)
+check("lead_time count ${count} vs ${customer_orders} customer orders" count EQUAL customer_orders)
+foreach(percentile 50 90 99)
+    string(JSON reported GET "${json}" percentiles lead_time p${percentile})
+    to_milli(${reported} reported)
+    exact_percentile("${lead_times}" ${percentile} exact)
+    math(EXPR error "${reported} - ${exact} * 1000")
+    if(error LESS 0)
+        math(EXPR error "-${error}")
+    endif()
+    math(EXPR allowed "${exact} * 32 + 1000")   # 3.2% plus one minute of rounding
+    check("lead_time p${percentile}: ${reported} vs exact ${exact} min" error LESS_EQUAL allowed)
+endforeach()
+
+# Little's law: arrival rate x measured time in queue ~ time-weighted average length
+string(JSON queue_count LENGTH "${json}" queues)
+set(little_rows 0)
+math(EXPR last "${queue_count} - 1")
+foreach(index RANGE ${last})
+    string(JSON name GET "${json}" queues ${index} name)
+    string(JSON little ERROR_VARIABLE missing GET "${json}" queues ${index} little_length)
+    if(missing)
+        continue()
+    endif()
+    string(JSON average GET "${json}" queues ${index} avg_length)
+    to_milli(${little} little)
+    to_milli(${average} average)
+    math(EXPR error "${little} - ${average}")
+    if(error LESS 0)
+        math(EXPR error "-${error}")
+    endif()
+    math(EXPR allowed "${average} / 20 + 50")    # 5% plus 0.05 orders
+    check("Little's law for ${name}: ${little} vs ${average} (thousandths)" error LESS_EQUAL allowed)
+    math(EXPR little_rows "${little_rows} + 1")
+endforeach()
+check("Little's-law rows present" little_rows GREATER 0)
+
+message(STATUS "Reports in ${OUTPUT_DIR} passed: ${row_count} orders, ${little_rows} Little's-law rows")